@@ -0,0 +1,48 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+/**
+ * @file BenchmarkUtils.hpp
+ * @brief Timing helpers shared by the DSP benchmarks
+ */
+
+namespace Benchmark {
+    inline volatile float sink = 0.0f; ///< Receives results, so the compiler cannot drop the measured work
+
+    /**
+     * @brief Keep a result alive so the compiler cannot drop the measured work
+     * @param value Result of the measured work
+     */
+    inline void consume(float value) {
+        sink = value;
+    }
+
+    /**
+     * @brief Measure the time per item of a workload
+     *
+     * The workload runs once to warm up caches and branch predictors, then repeatedly;
+     * the fastest run is reported because it is the least disturbed by the rest of the system.
+     * @param itemsPerRun Number of items (samples, calls) one run processes
+     * @param workload Function performing one run
+     * @param runs Number of timed runs
+     * @return Nanoseconds per item of the fastest run
+     */
+    template <typename Workload>
+    double nanosecondsPerItem(int itemsPerRun, Workload&& workload, int runs = 200) {
+        using Clock = std::chrono::steady_clock;
+
+        workload();
+
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < runs; ++run) {
+            const auto start = Clock::now();
+            workload();
+            const auto end = Clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+
+        return best / itemsPerRun;
+    }
+}
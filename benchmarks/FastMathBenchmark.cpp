@@ -0,0 +1,260 @@
+#include "BenchmarkUtils.hpp"
+#include "FastMath.hpp"
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+/**
+ * @file FastMathBenchmark.cpp
+ * @brief Accuracy and throughput of the FastMath approximations against the std:: functions
+ *
+ * Every approximation is swept over the input range its documentation gives an error bound for;
+ * the benchmark fails if the measured maximum error exceeds that bound. Throughput is reported
+ * as ns/call next to the std:: function it replaces.
+ */
+
+namespace {
+    constexpr int sweepPoints = 1 << 20; ///< Inputs per accuracy sweep
+    constexpr int timingPoints = 4096;   ///< Inputs per timed run (fits in the L1 cache)
+
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+
+    /**
+     * @brief Error measure of a sweep
+     */
+    enum class ErrorKind {
+        Absolute, ///< |approximation - reference|
+        Relative  ///< |approximation - reference| / |reference|
+    };
+
+    /**
+     * @brief One accuracy check: an approximation, its reference and the documented bound
+     */
+    struct AccuracyCheck {
+        const char* name;                       ///< Function and input range
+        std::function<float(float)> approximation; ///< FastMath function
+        std::function<double(double)> reference;   ///< Exact function in double precision
+        float lower;                            ///< Lowest input
+        float upper;                            ///< Highest input
+        ErrorKind kind;                         ///< Error measure
+        double bound;                           ///< Documented maximum error
+        bool logarithmic = false;               ///< Space the inputs logarithmically (positive ranges only)
+    };
+
+    /**
+     * @brief One throughput comparison
+     */
+    struct TimingCheck {
+        const char* name;                       ///< Function name
+        std::function<void(const float*, float*, int)> fast;     ///< FastMath version over an array
+        std::function<void(const float*, float*, int)> standard; ///< std:: version over an array
+        float lower;                            ///< Lowest input
+        float upper;                            ///< Highest input
+    };
+
+    /**
+     * @brief Apply a scalar function to an array
+     */
+    template <typename Function>
+    void applyScalar(Function function, const float* input, float* output, int numValues) {
+        for (int i = 0; i < numValues; ++i) {
+            output[i] = function(input[i]);
+        }
+    }
+
+    /**
+     * @brief Apply a SIMD-capable function to an array, one register at a time
+     */
+    template <typename Function>
+    void applySIMD(Function function, const float* input, float* output, int numValues) {
+        constexpr int width = static_cast<int>(SIMDFloat::SIMDNumElements);
+        for (int i = 0; i + width <= numValues; i += width) {
+            function(SIMDFloat::fromRawArray(input + i)).copyToRawArray(output + i);
+        }
+    }
+
+    /**
+     * @brief Evenly spaced inputs over a range
+     * @param logarithmic Space the inputs evenly in log2(x) instead of x
+     */
+    std::vector<float> makeInputs(float lower, float upper, int numValues, bool logarithmic = false) {
+        std::vector<float> inputs(static_cast<size_t>(numValues));
+        for (int i = 0; i < numValues; ++i) {
+            const double position = static_cast<double>(i) / numValues;
+            inputs[static_cast<size_t>(i)] = logarithmic
+                ? static_cast<float>(std::exp2(std::log2(lower) + (std::log2(upper) - std::log2(lower)) * position))
+                : static_cast<float>(lower + (static_cast<double>(upper) - lower) * position);
+        }
+        return inputs;
+    }
+
+    /**
+     * @brief Sweep one approximation and compare its maximum error with the bound
+     * @return True if the bound holds
+     */
+    bool runAccuracyCheck(const AccuracyCheck& check) {
+        double maxError = 0.0;
+        float worstInput = check.lower;
+
+        for (const float x : makeInputs(check.lower, check.upper, sweepPoints, check.logarithmic)) {
+            const double reference = check.reference(static_cast<double>(x));
+            double error = std::abs(static_cast<double>(check.approximation(x)) - reference);
+            if (check.kind == ErrorKind::Relative) {
+                error /= std::abs(reference);
+            }
+            if (error > maxError) {
+                maxError = error;
+                worstInput = x;
+            }
+        }
+
+        const bool passed = maxError <= check.bound;
+        std::printf("%-36s %4s %10.3g %10.3g  at %-12.6g %s\n", check.name,
+                    check.kind == ErrorKind::Absolute ? "abs" : "rel", maxError, check.bound,
+                    static_cast<double>(worstInput), passed ? "ok" : "FAILED");
+        return passed;
+    }
+
+    /**
+     * @brief Check that a SIMD evaluation matches the scalar one lane by lane
+     * @return True if every lane matches
+     */
+    bool runSIMDCheck(const char* name, const std::function<float(float)>& scalar,
+                      const std::function<SIMDFloat(SIMDFloat)>& vector, float lower, float upper) {
+        const auto inputs = makeInputs(lower, upper, sweepPoints);
+        std::vector<float> outputs(inputs.size());
+        applySIMD(vector, inputs.data(), outputs.data(), sweepPoints);
+
+        double maxDifference = 0.0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            maxDifference = std::max(maxDifference, static_cast<double>(std::abs(outputs[i] - scalar(inputs[i]))));
+        }
+
+        // Both evaluate the same operations; only FMA contraction may differ
+        const bool passed = maxDifference <= 1.0e-6;
+        std::printf("%-36s %4s %10.3g %10.3g  %-15s %s\n", name, "simd", maxDifference, 1.0e-6, "", passed ? "ok" : "FAILED");
+        return passed;
+    }
+
+    /**
+     * @brief Time a FastMath function and its std:: counterpart over the same inputs
+     */
+    void runTimingCheck(const TimingCheck& check) {
+        const auto inputs = makeInputs(check.lower, check.upper, timingPoints);
+        std::vector<float> outputs(inputs.size());
+
+        const double fastTime = Benchmark::nanosecondsPerItem(timingPoints, [&] {
+            check.fast(inputs.data(), outputs.data(), timingPoints);
+            Benchmark::consume(outputs[timingPoints / 2]);
+        });
+        const double standardTime = Benchmark::nanosecondsPerItem(timingPoints, [&] {
+            check.standard(inputs.data(), outputs.data(), timingPoints);
+            Benchmark::consume(outputs[timingPoints / 2]);
+        });
+
+        std::printf("%-24s %10.2f %10.2f %7.2fx\n", check.name, fastTime, standardTime, standardTime / fastTime);
+    }
+}
+
+int main() {
+    constexpr double twoPi = juce::MathConstants<double>::twoPi;
+    const auto sinCycleReference = [twoPi](double phase) { return std::sin(twoPi * phase); };
+    const auto sinReference = [](double x) { return std::sin(x); };
+    const auto tanhReference = [](double x) { return std::tanh(x); };
+    const auto exp2Reference = [](double x) { return std::exp2(x); };
+    const auto log2Reference = [](double x) { return std::log2(x); };
+    const auto roundReference = [](double x) { return std::round(x); };
+
+    const auto sinCycle = [](float phase) { return FastMath::sinCycle(phase); };
+    const auto sin = [](float x) { return FastMath::sin(x); };
+    const auto tanh = [](float x) { return FastMath::tanh(x); };
+    const auto round = [](float x) { return FastMath::round(x); };
+    const auto exp2 = [](float x) { return FastMath::exp2(x); };
+    const auto log2 = [](float x) { return FastMath::log2(x); };
+
+    // pow() is swept over the base for a few fixed exponents
+    const auto pow = [](float exponent) {
+        return [exponent](float base) { return FastMath::pow(base, exponent); };
+    };
+    const auto powReference = [](double exponent) {
+        return [exponent](double base) { return std::pow(base, exponent); };
+    };
+
+    const std::vector<AccuracyCheck> accuracyChecks{
+        {"sinCycle, phase [0, 1)", sinCycle, sinCycleReference, 0.0f, 1.0f, ErrorKind::Absolute, 4.1e-7},
+        {"sinCycle, |phase| < 10", sinCycle, sinCycleReference, -10.0f, 10.0f, ErrorKind::Absolute, 3.0e-6},
+        {"sin, |x| < 2 pi", sin, sinReference, -6.2831853f, 6.2831853f, ErrorKind::Absolute, 8.2e-7},
+        {"sin, |x| < 20", sin, sinReference, -20.0f, 20.0f, ErrorKind::Absolute, 2.0e-6},
+        {"sin, |x| < 1000", sin, sinReference, -1000.0f, 1000.0f, ErrorKind::Absolute, 1.2e-4},
+        {"tanh, |x| < 20", tanh, tanhReference, -20.0f, 20.0f, ErrorKind::Absolute, 7.0e-6},
+        {"round, |x| < 2^10", round, roundReference, -1024.0f, 1024.0f, ErrorKind::Absolute, 0.0},
+        {"round, |x| < 1", round, roundReference, -1.0f, 1.0f, ErrorKind::Absolute, 0.0},
+        {"round, |x| < 2^31", round, roundReference, -2147483520.0f, 2147483520.0f, ErrorKind::Absolute, 0.0},
+        {"exp2, x [-126, 128)", exp2, exp2Reference, -126.0f, 128.0f, ErrorKind::Relative, 1.8e-7},
+        {"log2, x [2^-16, 2^16]", log2, log2Reference, 1.5258789e-5f, 65536.0f, ErrorKind::Absolute, 3.0e-6, true},
+        {"log2, positive normals", log2, log2Reference, 1.1754944e-38f, 3.4e38f, ErrorKind::Absolute, 1.1e-5, true},
+        {"pow, base^0.5, results [1e-6, 1e6]", pow(0.5f), powReference(0.5), 1.0e-12f, 1.0e12f, ErrorKind::Relative, 1.0e-5, true},
+        {"pow, base^3, results [1e-6, 1e6]", pow(3.0f), powReference(3.0), 1.0e-2f, 1.0e2f, ErrorKind::Relative, 1.0e-5, true},
+        {"pow, base^-2, results [1e-6, 1e6]", pow(-2.0f), powReference(-2.0), 1.0e-3f, 1.0e3f, ErrorKind::Relative, 1.0e-5, true},
+    };
+
+    bool passed = true;
+
+    std::printf("Accuracy (max error over %d points)\n", sweepPoints);
+    std::printf("%-36s %4s %10s %10s  %-15s\n", "Function", "", "measured", "bound", "worst input");
+    for (const auto& check : accuracyChecks) {
+        passed = runAccuracyCheck(check) && passed;
+    }
+
+    // The SIMD voice kernels use the same templates on SIMDRegister<float>
+    passed = runSIMDCheck("sinCycle, SIMDRegister", sinCycle, [](SIMDFloat x) { return FastMath::sinCycle(x); }, -10.0f, 10.0f) && passed;
+    passed = runSIMDCheck("tanh, SIMDRegister", tanh, [](SIMDFloat x) { return FastMath::tanh(x); }, -20.0f, 20.0f) && passed;
+    passed = runSIMDCheck("round, SIMDRegister", round, [](SIMDFloat x) { return FastMath::round(x); }, -1024.0f, 1024.0f) && passed;
+
+    const std::vector<TimingCheck> timingChecks{
+        {"sinCycle / std::sin",
+         [&](const float* in, float* out, int n) { applyScalar(sinCycle, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::sin(juce::MathConstants<float>::twoPi * x); }, in, out, n); },
+         0.0f, 1.0f},
+        {"sinCycle SIMD / std::sin",
+         [](const float* in, float* out, int n) { applySIMD([](SIMDFloat x) { return FastMath::sinCycle(x); }, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::sin(juce::MathConstants<float>::twoPi * x); }, in, out, n); },
+         0.0f, 1.0f},
+        {"sin / std::sin",
+         [&](const float* in, float* out, int n) { applyScalar(sin, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::sin(x); }, in, out, n); },
+         -20.0f, 20.0f},
+        {"tanh / std::tanh",
+         [&](const float* in, float* out, int n) { applyScalar(tanh, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::tanh(x); }, in, out, n); },
+         -5.0f, 5.0f},
+        {"tanh SIMD / std::tanh",
+         [](const float* in, float* out, int n) { applySIMD([](SIMDFloat x) { return FastMath::tanh(x); }, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::tanh(x); }, in, out, n); },
+         -5.0f, 5.0f},
+        {"round / std::round",
+         [&](const float* in, float* out, int n) { applyScalar(round, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::round(x); }, in, out, n); },
+         -100.0f, 100.0f},
+        {"exp2 / std::exp2",
+         [&](const float* in, float* out, int n) { applyScalar(exp2, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::exp2(x); }, in, out, n); },
+         -10.0f, 10.0f},
+        {"log2 / std::log2",
+         [&](const float* in, float* out, int n) { applyScalar(log2, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::log2(x); }, in, out, n); },
+         0.001f, 1000.0f},
+        {"pow / std::pow",
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return FastMath::pow(x, 0.37f); }, in, out, n); },
+         [](const float* in, float* out, int n) { applyScalar([](float x) { return std::pow(x, 0.37f); }, in, out, n); },
+         0.001f, 1000.0f},
+    };
+
+    std::printf("\nThroughput (ns/call)\n");
+    std::printf("%-24s %10s %10s %8s\n", "Function", "FastMath", "std::", "speedup");
+    for (const auto& check : timingChecks) {
+        runTimingCheck(check);
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+#include "BenchmarkUtils.hpp"
+#include "Oscillator.hpp"
+#include <cstdio>
+#include <vector>
+
+/**
+ * @file OscillatorBenchmark.cpp
+ * @brief Per-waveform cost of the runtime OscType switch versus the compile-time dispatch
+ *
+ * Renders a fixed block of every oscillator type through the per-sample switch the oscillator
+ * used before (reproduced below) and through the OscType-specialized templates, resolved once
+ * per block. Reports ns/sample for both and fails if the two paths produce different waveforms.
+ */
+
+namespace {
+    constexpr int blockSize = 512;           ///< Samples per rendered block
+    constexpr double sampleRate = 48000.0;   ///< Sample rate in Hz
+    constexpr float frequency = 220.0f;      ///< Oscillator frequency in Hz
+    constexpr float tolerance = 1.0e-5f;     ///< Allowed difference between the two paths
+
+    /// The type is read through a volatile per block, like ChainSettings::oscType, so it is unknown at compile time
+    volatile int selectedType = 0;
+
+    /**
+     * @brief Previous OscillatorUtils::getOscSample(): switches on the type for every sample
+     */
+    float legacyOscSample(OscType type, double angle, float frequency, double sampleRate) {
+        float baseSample = 0.0f;
+
+        switch (type) {
+        case OscType::Sine:
+            baseSample = static_cast<float>(std::sin(angle));
+            baseSample += std::sin(angle * 2.0) * 0.1f + std::sin(angle * 3.0) * 0.05f;
+            break;
+        case OscType::Square:
+            baseSample = (std::sin(angle) >= 0.0 ? 1.0f : -1.0f);
+            baseSample *= (0.95f + std::sin(angle * 5.0) * 0.08f);
+            baseSample += std::sin(angle * 7.3) * 0.12f;
+            break;
+        case OscType::Saw:
+            baseSample = static_cast<float>(
+                2.0 * (angle / juce::MathConstants<double>::twoPi -
+                       std::floor(0.5 + angle / juce::MathConstants<double>::twoPi)));
+            baseSample += std::sin(angle * 4.0) * 0.08f + std::sin(angle * 6.0) * 0.04f;
+            break;
+        case OscType::Triangle:
+            baseSample = 2.0f * static_cast<float>(
+                std::abs(2.0 * (angle / juce::MathConstants<double>::twoPi -
+                               std::floor(0.5 + angle / juce::MathConstants<double>::twoPi)))) - 1.0f;
+            baseSample += std::sin(angle * 2.3) * 0.06f + std::sin(angle * 3.7) * 0.04f;
+            break;
+        default:
+            return 0.0f;
+        }
+
+        float nasalFreq = frequency * 2.7f;
+        double nasalAngle = (nasalFreq / sampleRate) * angle;
+        float nasalComponent = std::sin(nasalAngle) * 0.15f;
+
+        float vibratoMod = 1.0f + std::sin(angle * 0.01f * frequency / 440.0f) * 0.08f;
+
+        float toadSample = baseSample * vibratoMod + nasalComponent * baseSample;
+
+        float distortion = toadSample * 0.3f;
+        if (distortion > 0.1f) {
+            distortion = 0.1f + (distortion - 0.1f) * 0.7f;
+        } else if (distortion < -0.1f) {
+            distortion = -0.1f + (distortion + 0.1f) * 0.7f;
+        }
+
+        return baseSample * 0.7f + (toadSample + distortion) * 0.3f;
+    }
+
+    /**
+     * @brief Previous OscillatorUtils::getPeriodicSample(): switches on the type for every sample
+     */
+    float legacyPeriodicSample(OscType type, double angle) {
+        const double saw = 2.0 * (angle / juce::MathConstants<double>::twoPi -
+                                  std::floor(0.5 + angle / juce::MathConstants<double>::twoPi));
+
+        switch (type) {
+        case OscType::Sine:
+            return static_cast<float>(std::sin(angle) + std::sin(angle * 2.0) * 0.1 + std::sin(angle * 3.0) * 0.05);
+        case OscType::Square:
+            return static_cast<float>((std::sin(angle) >= 0.0 ? 1.0 : -1.0) * (0.95 + std::sin(angle * 5.0) * 0.08) +
+                                      std::sin(angle * 7.0) * 0.12);
+        case OscType::Saw:
+            return static_cast<float>(saw + std::sin(angle * 4.0) * 0.08 + std::sin(angle * 6.0) * 0.04);
+        case OscType::Triangle:
+            return static_cast<float>(2.0 * std::abs(saw) - 1.0 + std::sin(angle * 2.0) * 0.06 +
+                                      std::sin(angle * 4.0) * 0.04);
+        default:
+            return 0.0f;
+        }
+    }
+
+    /**
+     * @brief Render a block through the per-sample switch
+     */
+    void renderLegacyBlock(float* output, int numSamples, double angleDelta) {
+        const auto type = static_cast<OscType>(selectedType);
+        for (int sample = 0; sample < numSamples; ++sample) {
+            output[sample] = legacyOscSample(type, angleDelta * sample, frequency, sampleRate);
+        }
+    }
+
+    /**
+     * @brief Render a block of one specialized waveform
+     */
+    template <OscType Type>
+    void renderSpecializedBlock(float* output, int numSamples, double angleDelta) {
+        for (int sample = 0; sample < numSamples; ++sample) {
+            output[sample] = OscillatorUtils::getOscSample<Type>(angleDelta * sample, frequency, sampleRate);
+        }
+    }
+
+    /**
+     * @brief Render a block with the type resolved once through a function-pointer table
+     */
+    void renderSpecializedBlock(float* output, int numSamples, double angleDelta) {
+        using BlockRenderer = void (*)(float*, int, double);
+        static constexpr std::array<BlockRenderer, static_cast<size_t>(OscType::NumTypes)> renderers{
+            &renderSpecializedBlock<OscType::Sine>, &renderSpecializedBlock<OscType::Square>,
+            &renderSpecializedBlock<OscType::Saw>, &renderSpecializedBlock<OscType::Triangle>
+        };
+
+        renderers[static_cast<size_t>(selectedType)](output, numSamples, angleDelta);
+    }
+
+    /**
+     * @brief Render one wavetable cycle through the per-sample switch
+     */
+    void renderLegacyCycle(float* output, int numSamples) {
+        const auto type = static_cast<OscType>(selectedType);
+        const double angleDelta = juce::MathConstants<double>::twoPi / numSamples;
+        for (int sample = 0; sample < numSamples; ++sample) {
+            output[sample] = legacyPeriodicSample(type, angleDelta * sample);
+        }
+    }
+
+    /**
+     * @brief Largest difference between two blocks
+     */
+    float maxDifference(const std::vector<float>& a, const std::vector<float>& b) {
+        float difference = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i) {
+            difference = std::max(difference, std::abs(a[i] - b[i]));
+        }
+        return difference;
+    }
+}
+
+int main() {
+    constexpr const char* names[] = {"Sine", "Square", "Saw", "Triangle"};
+    const double angleDelta = OscillatorUtils::calculateAngleDelta(frequency, sampleRate);
+
+    std::vector<float> legacy(blockSize);
+    std::vector<float> specialized(blockSize);
+    bool passed = true;
+
+    std::printf("getOscSample, %d-sample block (ns/sample)\n", blockSize);
+    std::printf("%-10s %10s %12s %8s\n", "Waveform", "switch", "specialized", "speedup");
+
+    for (int type = 0; type < static_cast<int>(OscType::NumTypes); ++type) {
+        selectedType = type;
+
+        const double legacyTime = Benchmark::nanosecondsPerItem(blockSize, [&] {
+            renderLegacyBlock(legacy.data(), blockSize, angleDelta);
+            Benchmark::consume(legacy[blockSize - 1]);
+        });
+        const double specializedTime = Benchmark::nanosecondsPerItem(blockSize, [&] {
+            renderSpecializedBlock(specialized.data(), blockSize, angleDelta);
+            Benchmark::consume(specialized[blockSize - 1]);
+        });
+
+        std::printf("%-10s %10.2f %12.2f %7.2fx\n", names[type], legacyTime, specializedTime, legacyTime / specializedTime);
+
+        if (maxDifference(legacy, specialized) > tolerance) {
+            std::printf("  FAILED: waveform differs from the switch path\n");
+            passed = false;
+        }
+    }
+
+    std::printf("\ngetPeriodicSample, %d-sample wavetable cycle (ns/sample)\n", blockSize);
+    std::printf("%-10s %10s %12s %8s\n", "Waveform", "switch", "specialized", "speedup");
+
+    for (int type = 0; type < static_cast<int>(OscType::NumTypes); ++type) {
+        selectedType = type;
+
+        const double legacyTime = Benchmark::nanosecondsPerItem(blockSize, [&] {
+            renderLegacyCycle(legacy.data(), blockSize);
+            Benchmark::consume(legacy[blockSize - 1]);
+        });
+        const double specializedTime = Benchmark::nanosecondsPerItem(blockSize, [&] {
+            OscillatorUtils::getCycleRenderer(static_cast<OscType>(selectedType))(specialized.data(), blockSize);
+            Benchmark::consume(specialized[blockSize - 1]);
+        });
+
+        std::printf("%-10s %10.2f %12.2f %7.2fx\n", names[type], legacyTime, specializedTime, legacyTime / specializedTime);
+
+        if (maxDifference(legacy, specialized) > tolerance) {
+            std::printf("  FAILED: waveform differs from the switch path\n");
+            passed = false;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
@@ -4,6 +4,7 @@
  */
 
 #include "ADSRComponent.hpp"
+#include "magic_enum/magic_enum.hpp"
 
 ADSRComponent::ADSRComponent()
 {
@@ -13,18 +14,82 @@ ADSRComponent::ADSRComponent()
     // Initialize plot buffers
     plotBuffer.fill(0.0f);
     timeBuffer.fill(0.0f);
-
-    // Start timer for real-time updates (60 FPS)
-    startTimer(16);
 }
 
-ADSRComponent::~ADSRComponent()
+void ADSRComponent::paint(juce::Graphics& g)
 {
-    stopTimer();
+    auto bounds = getLocalBounds().toFloat().reduced(10);
+
+    // Static layer (frame, grid, curve and control points), rendered only when it changes
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (backgroundImage.isNull() || !juce::approximatelyEqual(scale, backgroundScale))
+        renderBackground(scale);
+
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
+
+    // Draw real-time envelope plot
+    drawEnvelopePlot(g);
+
+    // Current envelope value as large point
+    if (envelopeActive.load())
+    {
+        auto currentPos = getEnvelopePositionOnCurve(currentEnvelopeValue.load(), currentEnvelopeTime.load());
+
+        // Pulsing effect
+        float pulseSize = 8.0f + 4.0f * std::sin(animationPhase);
+
+        // Color based on ADSR phase
+        juce::Colour phaseColor;
+        switch (adsrState.load())
+        {
+            case 1: phaseColor = juce::Colours::red; break;      // Attack
+            case 2: phaseColor = juce::Colours::yellow; break;   // Decay
+            case 3: phaseColor = juce::Colours::green; break;    // Sustain
+            case 4: phaseColor = juce::Colours::blue; break;     // Release
+            default: phaseColor = juce::Colours::white; break;
+        }
+
+        // Glowing effect
+        g.setColour(phaseColor.withAlpha(0.3f));
+        g.fillEllipse(currentPos.x - pulseSize, currentPos.y - pulseSize,
+                     pulseSize * 2, pulseSize * 2);
+
+        g.setColour(phaseColor);
+        g.fillEllipse(currentPos.x - 6, currentPos.y - 6, 12, 12);
+
+        g.setColour(juce::Colours::white);
+        g.drawEllipse(currentPos.x - 6, currentPos.y - 6, 12, 12, 2.0f);
+    }
+
+    // Display ADSR phase
+    if (envelopeActive.load())
+    {
+        juce::String phaseText;
+        switch (adsrState.load())
+        {
+            case 1: phaseText = "ATTACK"; break;
+            case 2: phaseText = "DECAY"; break;
+            case 3: phaseText = "SUSTAIN"; break;
+            case 4: phaseText = "RELEASE"; break;
+            default: phaseText = "IDLE"; break;
+        }
+
+        g.setColour(juce::Colours::white);
+        g.setFont(14.0f);
+        g.drawText(phaseText, static_cast<int>(bounds.getX()), static_cast<int>(bounds.getY() - 20), 100, 20, juce::Justification::left);
+    }
 }
 
-void ADSRComponent::paint(juce::Graphics& g)
+void ADSRComponent::renderBackground(float scale)
 {
+    backgroundScale = scale;
+    backgroundImage = juce::Image(juce::Image::ARGB,
+                                  juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                  juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)), true);
+
+    juce::Graphics g(backgroundImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     auto bounds = getLocalBounds().toFloat().reduced(10);
 
     // Background
@@ -59,9 +124,6 @@ void ADSRComponent::paint(juce::Graphics& g)
     g.setColour(primaryColor);
     g.strokePath(path, juce::PathStrokeType(3.0f, juce::PathStrokeType::curved));
 
-    // Draw real-time envelope plot
-    drawEnvelopePlot(g);
-
     // Draw control points
     auto attackPoint = getAttackPoint();
     auto decayPoint = getDecayPoint();
@@ -82,37 +144,6 @@ void ADSRComponent::paint(juce::Graphics& g)
     drawControlPoint(sustainPoint, currentDragMode == DragMode::Sustain);
     drawControlPoint(releasePoint, currentDragMode == DragMode::Release);
 
-    // Current envelope value as large point
-    if (envelopeActive.load())
-    {
-        auto currentPos = getEnvelopePositionOnCurve(currentEnvelopeValue.load(), currentEnvelopeTime.load());
-
-        // Pulsing effect
-        float pulseSize = 8.0f + 4.0f * std::sin(animationPhase);
-
-        // Color based on ADSR phase
-        juce::Colour phaseColor;
-        switch (adsrState.load())
-        {
-            case 1: phaseColor = juce::Colours::red; break;      // Attack
-            case 2: phaseColor = juce::Colours::yellow; break;   // Decay
-            case 3: phaseColor = juce::Colours::green; break;    // Sustain
-            case 4: phaseColor = juce::Colours::blue; break;     // Release
-            default: phaseColor = juce::Colours::white; break;
-        }
-
-        // Glowing effect
-        g.setColour(phaseColor.withAlpha(0.3f));
-        g.fillEllipse(currentPos.x - pulseSize, currentPos.y - pulseSize,
-                     pulseSize * 2, pulseSize * 2);
-
-        g.setColour(phaseColor);
-        g.fillEllipse(currentPos.x - 6, currentPos.y - 6, 12, 12);
-
-        g.setColour(juce::Colours::white);
-        g.drawEllipse(currentPos.x - 6, currentPos.y - 6, 12, 12, 2.0f);
-    }
-
     // Labels
     g.setColour(juce::Colours::white);
     g.setFont(12.0f);
@@ -121,39 +152,34 @@ void ADSRComponent::paint(juce::Graphics& g)
     g.drawText("D", static_cast<int>(decayPoint.x - 10), static_cast<int>(bounds.getBottom() + 5), 20, 15, juce::Justification::centred);
     g.drawText("S", static_cast<int>(sustainPoint.x - 10), static_cast<int>(bounds.getBottom() + 5), 20, 15, juce::Justification::centred);
     g.drawText("R", static_cast<int>(releasePoint.x - 10), static_cast<int>(bounds.getBottom() + 5), 20, 15, juce::Justification::centred);
+}
 
-    // Display ADSR phase
-    if (envelopeActive.load())
-    {
-        juce::String phaseText;
-        switch (adsrState.load())
-        {
-            case 1: phaseText = "ATTACK"; break;
-            case 2: phaseText = "DECAY"; break;
-            case 3: phaseText = "SUSTAIN"; break;
-            case 4: phaseText = "RELEASE"; break;
-            default: phaseText = "IDLE"; break;
-        }
-
-        g.setColour(juce::Colours::white);
-        g.setFont(14.0f);
-        g.drawText(phaseText, static_cast<int>(bounds.getX()), static_cast<int>(bounds.getY() - 20), 100, 20, juce::Justification::left);
-    }
+void ADSRComponent::invalidateBackground()
+{
+    backgroundImage = {};
+    repaint();
 }
 
 void ADSRComponent::resized()
 {
     // Called when the component changes size
+    backgroundImage = {};
 }
 
 void ADSRComponent::mouseDown(const juce::MouseEvent& event)
 {
+    if (event.mods.isPopupMenu())
+    {
+        showCurveMenu(event.position);
+        return;
+    }
+
     lastMousePos = event.position;
     currentDragMode = getHitTest(event.position);
 
     if (currentDragMode != DragMode::None)
     {
-        repaint();
+        invalidateBackground();
     }
 }
 
@@ -206,13 +232,16 @@ void ADSRComponent::mouseDrag(const juce::MouseEvent& event)
         onParameterChanged(attackValue, decayValue, sustainValue, releaseValue);
     }
 
-    repaint();
+    if (valuesChanged)
+    {
+        invalidateBackground();
+    }
 }
 
 void ADSRComponent::mouseUp(const juce::MouseEvent& event)
 {
     currentDragMode = DragMode::None;
-    repaint();
+    invalidateBackground();
 }
 
 void ADSRComponent::mouseMove(const juce::MouseEvent& event)
@@ -231,33 +260,111 @@ void ADSRComponent::mouseMove(const juce::MouseEvent& event)
 
 void ADSRComponent::setAttack(float attack)
 {
-    attackValue = juce::jlimit(0.01f, 1.0f, attack);
-    repaint();
+    const float newValue = juce::jlimit(0.01f, 1.0f, attack);
+    if (juce::exactlyEqual(newValue, attackValue))
+        return;
+
+    attackValue = newValue;
+    invalidateBackground();
 }
 
 void ADSRComponent::setDecay(float decay)
 {
-    decayValue = juce::jlimit(0.01f, 1.0f, decay);
-    repaint();
+    const float newValue = juce::jlimit(0.01f, 1.0f, decay);
+    if (juce::exactlyEqual(newValue, decayValue))
+        return;
+
+    decayValue = newValue;
+    invalidateBackground();
 }
 
 void ADSRComponent::setSustain(float sustain)
 {
-    sustainValue = juce::jlimit(0.0f, 1.0f, sustain);
-    repaint();
+    const float newValue = juce::jlimit(0.0f, 1.0f, sustain);
+    if (juce::exactlyEqual(newValue, sustainValue))
+        return;
+
+    sustainValue = newValue;
+    invalidateBackground();
 }
 
 void ADSRComponent::setRelease(float release)
 {
-    releaseValue = juce::jlimit(0.01f, 1.0f, release);
-    repaint();
+    const float newValue = juce::jlimit(0.01f, 1.0f, release);
+    if (juce::exactlyEqual(newValue, releaseValue))
+        return;
+
+    releaseValue = newValue;
+    invalidateBackground();
+}
+
+void ADSRComponent::setCurveShapes(ADSREnvelope::CurveShape attack, ADSREnvelope::CurveShape decay,
+                                   ADSREnvelope::CurveShape release)
+{
+    if (attack == attackCurve && decay == decayCurve && release == releaseCurve)
+        return;
+
+    attackCurve = attack;
+    decayCurve = decay;
+    releaseCurve = release;
+    invalidateBackground();
+}
+
+void ADSRComponent::showCurveMenu(juce::Point<float> position)
+{
+    // Stage under the mouse (the sustain stage has no curve)
+    ADSREnvelope::CurveShape ADSRComponent::* curve = nullptr;
+    juce::String stageName;
+
+    if (position.x <= getAttackPoint().x)
+    {
+        curve = &ADSRComponent::attackCurve;
+        stageName = "Attack";
+    }
+    else if (position.x <= getDecayPoint().x)
+    {
+        curve = &ADSRComponent::decayCurve;
+        stageName = "Decay";
+    }
+    else if (position.x >= getSustainPoint().x)
+    {
+        curve = &ADSRComponent::releaseCurve;
+        stageName = "Release";
+    }
+
+    if (curve == nullptr)
+        return;
+
+    juce::PopupMenu menu;
+    menu.addSectionHeader(stageName + " Curve");
+
+    for (const auto shape : magic_enum::enum_values<ADSREnvelope::CurveShape>())
+    {
+        const auto name = magic_enum::enum_name(shape);
+        menu.addItem(static_cast<int>(shape) + 1, juce::String(name.data(), name.size()), true, shape == this->*curve);
+    }
+
+    juce::Component::SafePointer<ADSRComponent> safeThis(this);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this).withMousePosition(),
+                       [safeThis, curve](int result)
+                       {
+                           if (safeThis == nullptr || result == 0)
+                               return;
+
+                           safeThis.getComponent()->*curve = static_cast<ADSREnvelope::CurveShape>(result - 1);
+                           safeThis->invalidateBackground();
+
+                           if (safeThis->onCurveShapesChanged)
+                               safeThis->onCurveShapesChanged(safeThis->attackCurve, safeThis->decayCurve,
+                                                              safeThis->releaseCurve);
+                       });
 }
 
 void ADSRComponent::updateColors(juce::Colour primary, juce::Colour secondary)
 {
     primaryColor = primary;
     secondaryColor = secondary;
-    repaint();
+    invalidateBackground();
 }
 
 void ADSRComponent::updateEnvelopeValue(float currentValue, bool isActive, float timeInEnvelope)
@@ -285,28 +392,38 @@ void ADSRComponent::setADSRState(int state)
     adsrState.store(state);
 }
 
-void ADSRComponent::timerCallback()
+void ADSRComponent::advanceFrame()
 {
     // Update animation phase for pulsing
     animationPhase += 0.2f;
     if (animationPhase > juce::MathConstants<float>::twoPi)
         animationPhase -= juce::MathConstants<float>::twoPi;
 
-    // Only repaint when envelope is active
+    // Only the overlay changes: repaint where it is now and where it was in the previous frame
+    juce::Rectangle<int> overlayBounds;
     if (envelopeActive.load())
     {
-        repaint();
+        updateTrailPath();
+        overlayBounds = getOverlayBounds();
+    }
+    else
+    {
+        trailPath.clear();
     }
-}
 
-void ADSRComponent::drawEnvelopePlot(juce::Graphics& g)
-{
-    if (!envelopeActive.load()) return;
+    auto dirtyBounds = overlayBounds.getUnion(lastOverlayBounds);
+    lastOverlayBounds = overlayBounds;
 
-    auto bounds = getLocalBounds().toFloat().reduced(10);
+    if (!dirtyBounds.isEmpty())
+    {
+        repaint(dirtyBounds);
+    }
+}
 
+void ADSRComponent::updateTrailPath()
+{
     // Trail effect: previous values as fading line
-    juce::Path trailPath;
+    trailPath.clear();
     bool firstPoint = true;
 
     int currentWrite = plotWriteIndex.load();
@@ -337,8 +454,30 @@ void ADSRComponent::drawEnvelopePlot(juce::Graphics& g)
             }
         }
     }
+}
+
+juce::Rectangle<int> ADSRComponent::getOverlayBounds() const
+{
+    auto bounds = getLocalBounds().toFloat().reduced(10);
+
+    // Trail stroke
+    auto overlay = trailPath.getBounds().expanded(2.0f);
+
+    // Pulsing point at its largest size
+    auto currentPos = getEnvelopePositionOnCurve(currentEnvelopeValue.load(), currentEnvelopeTime.load());
+    overlay = overlay.getUnion(juce::Rectangle<float>(24.0f, 24.0f).withCentre(currentPos).expanded(2.0f));
+
+    // Phase text
+    overlay = overlay.getUnion({bounds.getX(), bounds.getY() - 20.0f, 100.0f, 20.0f});
+
+    return overlay.getSmallestIntegerContainer();
+}
+
+void ADSRComponent::drawEnvelopePlot(juce::Graphics& g)
+{
+    if (!envelopeActive.load()) return;
 
-    // Draw trail with fade
+    // Draw trail with fade (path is built in advanceFrame)
     if (!trailPath.isEmpty())
     {
         g.setColour(primaryColor.withAlpha(0.4f));
@@ -386,11 +525,11 @@ juce::Path ADSRComponent::createADSRPath() const
 
     // Attack phase
     auto attackPoint = getAttackPoint();
-    path.lineTo(attackPoint);
+    addCurveToPath(path, {startX, startY}, attackPoint, attackCurve);
 
     // Decay phase
     auto decayPoint = getDecayPoint();
-    path.lineTo(decayPoint);
+    addCurveToPath(path, attackPoint, decayPoint, decayCurve);
 
     // Sustain phase (horizontal line)
     auto sustainPoint = getSustainPoint();
@@ -398,11 +537,32 @@ juce::Path ADSRComponent::createADSRPath() const
 
     // Release phase
     auto releasePoint = getReleasePoint();
-    path.lineTo(releasePoint);
+    addCurveToPath(path, sustainPoint, releasePoint, releaseCurve);
 
     return path;
 }
 
+void ADSRComponent::addCurveToPath(juce::Path& path, juce::Point<float> start, juce::Point<float> end,
+                                   ADSREnvelope::CurveShape shape)
+{
+    if (shape == ADSREnvelope::CurveShape::Linear)
+    {
+        path.lineTo(end);
+        return;
+    }
+
+    // Same curve the envelope renders; screen y grows downwards, so a rising stage has end.y < start.y
+    constexpr int numPoints = 32;
+    const bool rising = end.y < start.y;
+
+    for (int i = 1; i <= numPoints; ++i)
+    {
+        const float position = static_cast<float>(i) / numPoints;
+        const float progress = ADSREnvelope::getCurveProgress(shape, rising, position);
+        path.lineTo(start.x + (end.x - start.x) * position, start.y + (end.y - start.y) * progress);
+    }
+}
+
 ADSRComponent::DragMode ADSRComponent::getHitTest(juce::Point<float> position) const
 {
     const float hitRadius = 10.0f;
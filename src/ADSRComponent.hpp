@@ -6,6 +6,7 @@
 #pragma once
 
 #include "JuceHeader.h"
+#include "AudioEffects.hpp"
 #include <array>
 #include <atomic>
 
@@ -14,9 +15,10 @@
  *
  * This component provides a visual representation of an ADSR envelope with
  * interactive control points for adjusting attack, decay, sustain, and release
- * parameters. It also displays real-time envelope values and phase information.
+ * parameters. Right-clicking a stage selects its curve shape. It also displays
+ * real-time envelope values and phase information.
  */
-class ADSRComponent : public juce::Component, private juce::Timer
+class ADSRComponent : public juce::Component
 {
 public:
     /**
@@ -27,7 +29,7 @@ public:
     /**
      * @brief Destructor
      */
-    ~ADSRComponent() override;
+    ~ADSRComponent() override = default;
 
     /**
      * @brief Paint the component
@@ -88,6 +90,15 @@ public:
      */
     void setRelease(float release);
 
+    /**
+     * @brief Set the curve shapes of the time stages
+     * @param attack Attack curve shape
+     * @param decay Decay curve shape
+     * @param release Release curve shape
+     */
+    void setCurveShapes(ADSREnvelope::CurveShape attack, ADSREnvelope::CurveShape decay,
+                        ADSREnvelope::CurveShape release);
+
     /**
      * @brief Get current attack time
      * @return Attack time value (0.0 to 1.0)
@@ -120,6 +131,14 @@ public:
      */
     std::function<void(float attack, float decay, float sustain, float release)> onParameterChanged;
 
+    /**
+     * @brief Callback function for curve shape changes
+     *
+     * Called when a curve shape is selected from the context menu of a stage.
+     */
+    std::function<void(ADSREnvelope::CurveShape attack, ADSREnvelope::CurveShape decay,
+                       ADSREnvelope::CurveShape release)> onCurveShapesChanged;
+
     /**
      * @brief Update component color scheme
      * @param primary Primary color for envelope curve and control points
@@ -141,18 +160,23 @@ public:
      */
     void setADSRState(int state);
 
-private:
     /**
-     * @brief Timer callback for animation updates
+     * @brief Advance the animation by one frame and repaint the overlay area
      */
-    void timerCallback() override;
+    void advanceFrame();
 
+private:
     /// ADSR parameter values (0.0 to 1.0)
     float attackValue = 0.1f;   ///< Attack time parameter
     float decayValue = 0.3f;    ///< Decay time parameter
     float sustainValue = 0.7f;  ///< Sustain level parameter
     float releaseValue = 0.5f;  ///< Release time parameter
 
+    /// Curve shapes of the time stages
+    ADSREnvelope::CurveShape attackCurve = ADSREnvelope::CurveShape::Linear;  ///< Attack curve shape
+    ADSREnvelope::CurveShape decayCurve = ADSREnvelope::CurveShape::Linear;   ///< Decay curve shape
+    ADSREnvelope::CurveShape releaseCurve = ADSREnvelope::CurveShape::Linear; ///< Release curve shape
+
     /**
      * @brief Enumeration of drag interaction modes
      */
@@ -184,12 +208,56 @@ private:
     /// Animation
     float animationPhase = 0.0f; ///< Current animation phase for pulsing effects
 
+    /// Cached rendering
+    juce::Image backgroundImage;               ///< Static layer (frame, grid, curve, control points)
+    float backgroundScale = 0.0f;              ///< Display scale the static layer was rendered for
+    juce::Path trailPath;                      ///< Envelope trail, rebuilt every frame
+    juce::Rectangle<int> lastOverlayBounds;    ///< Area covered by the overlay in the previous frame
+
+    /**
+     * @brief Render the static parts of the component into the background image
+     * @param scale Physical pixels per logical pixel of the display
+     */
+    void renderBackground(float scale);
+
+    /**
+     * @brief Discard the background image after the curve, colors or control points changed
+     */
+    void invalidateBackground();
+
+    /**
+     * @brief Rebuild the envelope trail from the plot buffers
+     */
+    void updateTrailPath();
+
+    /**
+     * @brief Get the area covered by the dynamic overlay (trail, current point and phase text)
+     * @return Overlay bounds in component coordinates
+     */
+    juce::Rectangle<int> getOverlayBounds() const;
+
     /**
      * @brief Create the main ADSR curve path
      * @return Path representing the ADSR envelope curve
      */
     juce::Path createADSRPath() const;
 
+    /**
+     * @brief Add one stage of the envelope curve to a path
+     * @param path Path ending at the start point of the stage
+     * @param start Start point of the stage
+     * @param end End point of the stage
+     * @param shape Curve shape of the stage
+     */
+    static void addCurveToPath(juce::Path& path, juce::Point<float> start, juce::Point<float> end,
+                               ADSREnvelope::CurveShape shape);
+
+    /**
+     * @brief Show the curve shape menu of the stage at a position
+     * @param position Mouse position
+     */
+    void showCurveMenu(juce::Point<float> position);
+
     /**
      * @brief Draw the real-time envelope plot trail
      * @param g Graphics context for drawing
@@ -1,9 +1,12 @@
 #include "AudioEffects.hpp"
+#include "FastMath.hpp"
+#include "Utils.hpp"
 
 // ReverbEffect Implementation
 ReverbEffect::ReverbEffect() {
-    // Initialize default parameters
-    updateParameters();
+    // Fully dry until an amount is set
+    wetGain.reset(0.0f, 0.0f, 0);
+    dryGain.reset(1.0f, 1.0f, 0);
 }
 
 void ReverbEffect::prepare(double sampleRate, int maximumBlockSize, int numChannels) {
@@ -12,42 +15,301 @@ void ReverbEffect::prepare(double sampleRate, int maximumBlockSize, int numChann
     spec.numChannels = static_cast<juce::uint32>(numChannels);
 
     reverb.prepare(spec);
+    ecoNetwork.prepare(sampleRate);
+    normalNetwork.prepare(sampleRate);
+    highNetwork.prepare(sampleRate);
+    convolution.prepare(spec);
+    impulseResponseActive = false; // Checked again on the next convolution block
+    wetBuffer.setSize(numChannels, juce::jmax(1, maximumBlockSize));
+    wetGains.assign(static_cast<size_t>(wetBuffer.getNumSamples()), 0.0f);
+    dryGains.assign(static_cast<size_t>(wetBuffer.getNumSamples()), 1.0f);
+
+    gainRampSamples = juce::roundToInt(sampleRate * gainRampSeconds);
+    tailFadeSamples = juce::roundToInt(sampleRate * tailFadeSeconds);
+
+    configuredAmount = -1.0f;
+    updateParameters(currentAmount);
     isPrepared = true;
+    reset();
 }
 
 void ReverbEffect::processBlock(juce::AudioBuffer<float>& buffer) {
-    if (!isPrepared || currentAmount <= 0.0f) {
-        return; // Skip processing if not prepared or amount is zero
+    if (!isPrepared || isIdle()) {
+        return; // Fully dry and the tail has faded out
     }
 
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    reverb.process(context);
+    const bool takeInput = currentAmount > 0.0f;
+    if (takeInput) {
+        updateParameters(currentAmount);
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    const int chunkSize = wetBuffer.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int length = juce::jmin(chunkSize, numSamples - start);
+        wetGain.fillBlock(wetGains.data(), length);
+        dryGain.fillBlock(dryGains.data(), length);
+
+        renderWet(buffer, start, 0, length, takeInput);
+        mixWet(buffer, start, length);
+    }
+
+    finishTail();
+}
+
+void ReverbEffect::processBlock(juce::AudioBuffer<float>& buffer, const float* amounts, float targetAmount) {
+    const int numSamples = buffer.getNumSamples();
+    if (!isPrepared || numSamples == 0) {
+        return;
+    }
+
+    // Switching off lets the tail ring out like setAmount() does; the wet gain runs its fade
+    const bool fadingOut = targetAmount <= 0.0f;
+    if (fadingOut) {
+        setAmount(0.0f);
+        wetCrossfade.reset(1.0f, 1.0f, 0);
+    } else if (!wetGain.isSettled()) {
+        // Raised during the tail fade: blend from the faded gain instead of jumping to the amounts
+        crossfadeStartGain = wetGain.getCurrent();
+        wetCrossfade.reset(0.0f, 1.0f, gainRampSamples);
+    }
+
+    // Ramps are linear, so a ramp that starts and ends at zero keeps an idle reverb idle
+    if (isIdle() && amounts[0] <= 0.0f && amounts[numSamples - 1] <= 0.0f) {
+        return;
+    }
+
+    const int chunkSize = wetBuffer.getNumSamples();
+    float lastWetGain = 0.0f;
+
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int length = juce::jmin(chunkSize, numSamples - start);
+        const float* chunkAmounts = amounts + start;
+
+        // The dry gain follows the ramp per sample, the wet gain too unless the tail is fading
+        for (int i = 0; i < length; ++i) {
+            dryGains[static_cast<size_t>(i)] = 1.0f - dryReduction * chunkAmounts[i];
+        }
+
+        if (fadingOut) {
+            wetGain.fillBlock(wetGains.data(), length);
+            renderWet(buffer, start, 0, length, false);
+        } else {
+            if (wetCrossfade.isSettled()) {
+                for (int i = 0; i < length; ++i) {
+                    wetGains[static_cast<size_t>(i)] = wetScale * chunkAmounts[i];
+                }
+            } else {
+                // The crossfade weights are written first and replaced by the blended gains
+                wetCrossfade.fillBlock(wetGains.data(), length);
+                for (int i = 0; i < length; ++i) {
+                    auto& gain = wetGains[static_cast<size_t>(i)];
+                    gain = crossfadeStartGain + (wetScale * chunkAmounts[i] - crossfadeStartGain) * gain;
+                }
+            }
+
+            // The room can only change at control rate
+            for (int offset = 0; offset < length; offset += SmoothedParameter::controlBlockSize) {
+                const int controlLength = juce::jmin(SmoothedParameter::controlBlockSize, length - offset);
+                const float amount = chunkAmounts[offset + controlLength - 1];
+                if (amount > 0.0f) {
+                    updateParameters(amount);
+                }
+                renderWet(buffer, start, offset, controlLength, true);
+            }
+        }
+
+        mixWet(buffer, start, length);
+        lastWetGain = wetGains[static_cast<size_t>(length - 1)];
+    }
+
+    // Continue from the end of the ramp; a fading wet gain keeps its own ramp
+    const float lastAmount = juce::jlimit(0.0f, 1.0f, amounts[numSamples - 1]);
+    dryGain.reset(1.0f - dryReduction * lastAmount, 1.0f - dryReduction * lastAmount, 0);
+    if (!fadingOut) {
+        currentAmount = lastAmount;
+        wetGain.reset(lastWetGain, lastWetGain, 0); // Mid-crossfade, a later fade starts from the gain in use
+    }
+
+    finishTail();
 }
 
 void ReverbEffect::setAmount(float amount) {
-    currentAmount = juce::jlimit(0.0f, 1.0f, amount);
-    updateParameters();
+    const float newAmount = juce::jlimit(0.0f, 1.0f, amount);
+    if (juce::exactlyEqual(newAmount, currentAmount)) {
+        return;
+    }
+
+    // Switching off lets the tail ring out; other changes ramp quickly
+    currentAmount = newAmount;
+    wetGain.reset(wetGain.getCurrent(), wetScale * newAmount, newAmount > 0.0f ? gainRampSamples : tailFadeSamples);
+    dryGain.reset(dryGain.getCurrent(), 1.0f - dryReduction * newAmount, gainRampSamples);
+}
+
+void ReverbEffect::setMode(ReverbMode newMode) {
+    if (newMode == mode) {
+        return;
+    }
+
+    mode = newMode;
+    configuredAmount = -1.0f; // Only the previous engine followed the amount
+    clearEngines();
+}
+
+void ReverbEffect::loadImpulseResponse(juce::AudioBuffer<float>&& impulseResponse, double sampleRate) {
+    if (sampleRate > 0.0) {
+        impulseResponseSeconds.store(impulseResponse.getNumSamples() / sampleRate, std::memory_order_relaxed);
+    }
+    convolution.loadImpulseResponse(std::move(impulseResponse), sampleRate,
+                                    juce::dsp::Convolution::Stereo::yes, juce::dsp::Convolution::Trim::no,
+                                    juce::dsp::Convolution::Normalise::yes);
+}
+
+double ReverbEffect::getTailLengthSeconds(ReverbMode reverbMode, float amount) const {
+    if (amount <= 0.0f) {
+        return 0.0;
+    }
+
+    // The classic engine's comb feedback covers the same decay range as the delay networks
+    return reverbMode == ReverbMode::Convolution ? impulseResponseSeconds.load(std::memory_order_relaxed)
+                                                 : static_cast<double>(getNetworkDecaySeconds(amount));
 }
 
 void ReverbEffect::reset() {
-    if (isPrepared) {
-        reverb.reset();
+    clearEngines();
+
+    wetGain.reset(wetScale * currentAmount, wetScale * currentAmount, 0);
+    dryGain.reset(1.0f - dryReduction * currentAmount, 1.0f - dryReduction * currentAmount, 0);
+    wetCrossfade.reset(1.0f, 1.0f, 0);
+}
+
+void ReverbEffect::updateParameters(float amount) {
+    if (juce::exactlyEqual(amount, configuredAmount)) {
+        return;
+    }
+    configuredAmount = amount;
+
+    // Map reverb amount (0.0 to 1.0) to the room; the mix is applied in mixWet()
+    const float damping = juce::jmap(amount, 0.2f, 0.6f);
+
+    // Only the selected engine is configured; setMode() has the next one catch up
+    switch (mode) {
+        case ReverbMode::Classic: {
+            juce::dsp::Reverb::Parameters params;
+            params.roomSize = juce::jmap(amount, 0.0f, 0.8f);        // Room size
+            params.damping = damping;                                // Damping
+            params.wetLevel = 1.0f / 3.0f;                           // Unity wet gain (JUCE scales wet by 3)
+            params.dryLevel = 0.0f;                                  // Dry signal is mixed in mixWet()
+            params.width = 1.0f;                                     // Stereo width
+            params.freezeMode = 0.0f;                                // No freeze
+
+            reverb.setParameters(params);
+            break;
+        }
+        case ReverbMode::Eco:
+            ecoNetwork.setParameters(getNetworkDecaySeconds(amount), damping * 0.4f);
+            break;
+        case ReverbMode::Normal:
+            normalNetwork.setParameters(getNetworkDecaySeconds(amount), damping * 0.4f);
+            break;
+        case ReverbMode::High:
+            highNetwork.setParameters(getNetworkDecaySeconds(amount), damping * 0.4f);
+            break;
+        case ReverbMode::Convolution:
+            break; // The impulse response defines the room
+    }
+}
+
+float ReverbEffect::getNetworkDecaySeconds(float amount) {
+    // Same decay range as the comb feedback of the classic engine (about 0.5 s to 2.6 s)
+    return 0.5f * std::pow(5.2f, amount);
+}
+
+void ReverbEffect::renderWet(const juce::AudioBuffer<float>& buffer, int chunkStart, int offset, int numSamples,
+                             bool takeInput) {
+    const int numChannels = juce::jmin(buffer.getNumChannels(), wetBuffer.getNumChannels());
+    if (numChannels == 0) {
+        return;
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        if (takeInput) {
+            wetBuffer.copyFrom(channel, offset, buffer, channel, chunkStart + offset, numSamples);
+        } else {
+            wetBuffer.clear(channel, offset, numSamples);
+        }
+    }
+
+    if (mode == ReverbMode::Classic || mode == ReverbMode::Convolution) {
+        auto block = juce::dsp::AudioBlock<float>(wetBuffer)
+                         .getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                         .getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(numSamples));
+        juce::dsp::ProcessContextReplacing<float> context(block);
+
+        if (mode == ReverbMode::Classic) {
+            reverb.process(context);
+            return;
+        }
+
+        // New impulse responses are swapped in inside process(). Until the first one is active,
+        // the default engine (a one-sample unit impulse) passes the input through, so mute it.
+        convolution.process(context);
+        if (!impulseResponseActive) {
+            if (convolution.getCurrentIRSize() > 1) {
+                impulseResponseActive = true;
+                convolution.reset(); // Skip the crossfade from the pass-through engine
+            }
+            block.clear();
+        }
+        return;
+    }
+
+    float* left = wetBuffer.getWritePointer(0, offset);
+    float* right = numChannels > 1 ? wetBuffer.getWritePointer(1, offset) : nullptr;
+
+    switch (mode) {
+        case ReverbMode::Eco:     ecoNetwork.process(left, right, numSamples); break;
+        case ReverbMode::Normal:  normalNetwork.process(left, right, numSamples); break;
+        case ReverbMode::High:    highNetwork.process(left, right, numSamples); break;
+        case ReverbMode::Classic:
+        case ReverbMode::Convolution: break;
     }
 }
 
-void ReverbEffect::updateParameters() {
-    juce::dsp::Reverb::Parameters params;
+void ReverbEffect::mixWet(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) {
+    const int numChannels = juce::jmin(buffer.getNumChannels(), wetBuffer.getNumChannels());
+    const float* wetGainValues = wetGains.data();
+    const float* dryGainValues = dryGains.data();
 
-    // Map reverb amount (0.0 to 1.0) to reverb parameters
-    params.roomSize = juce::jmap(currentAmount, 0.0f, 0.8f);        // Room size
-    params.damping = juce::jmap(currentAmount, 0.2f, 0.6f);         // Damping
-    params.wetLevel = juce::jmap(currentAmount, 0.0f, 0.4f);        // Wet signal
-    params.dryLevel = 1.0f - (currentAmount * 0.3f);               // Dry signal stays dominant
-    params.width = 1.0f;                                            // Stereo width
-    params.freezeMode = 0.0f;                                       // No freeze
+    // Independent per sample, so the loop vectorizes
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* output = buffer.getWritePointer(channel, startSample);
+        const float* wet = wetBuffer.getReadPointer(channel);
 
-    reverb.setParameters(params);
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = output[i] * dryGainValues[i] + wet[i] * wetGainValues[i];
+        }
+    }
+}
+
+void ReverbEffect::finishTail() {
+    // The tail is inaudible now; clear it so the next use starts from silence
+    if (isIdle()) {
+        clearEngines();
+    }
+}
+
+void ReverbEffect::clearEngines() {
+    if (!isPrepared) {
+        return;
+    }
+
+    reverb.reset();
+    ecoNetwork.reset();
+    normalNetwork.reset();
+    highNetwork.reset();
+    convolution.reset();
 }
 
 // BitCrusherEffect Implementation
@@ -61,10 +323,27 @@ void BitCrusherEffect::processBlock(juce::AudioBuffer<float>& buffer, float crus
     const float crushFactor = juce::jlimit(0.01f, 1.0f, crushRate);
     const float inverse = 1.0f / crushFactor;
 
+    // Branch-free quantization so the loop can be vectorized
     for (int channel = 0; channel < numChannels; ++channel) {
         float* samples = buffer.getWritePointer(channel);
         for (int i = 0; i < numSamples; ++i) {
-            samples[i] = processSample(samples[i], crushFactor);
+            samples[i] = FastMath::round(samples[i] * inverse) * crushFactor;
+        }
+    }
+}
+
+void BitCrusherEffect::processBlock(juce::AudioBuffer<float>& buffer, const float* rates) {
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* samples = buffer.getWritePointer(channel);
+        for (int i = 0; i < numSamples; ++i) {
+            const float crushFactor = juce::jlimit(0.01f, 1.0f, rates[i]);
+            const float crushed = FastMath::round(samples[i] / crushFactor) * crushFactor;
+
+            // Select instead of branching, a rate of 1.0 passes the sample through
+            samples[i] = rates[i] >= 1.0f ? samples[i] : crushed;
         }
     }
 }
@@ -76,7 +355,7 @@ float BitCrusherEffect::processSample(float sample, float crushRate) {
 
     const float crushFactor = juce::jlimit(0.01f, 1.0f, crushRate);
     const float inverse = 1.0f / crushFactor;
-    return std::round(sample * inverse) * crushFactor;
+    return FastMath::round(sample * inverse) * crushFactor;
 }
 
 // ADSREnvelope Implementation
@@ -86,70 +365,265 @@ ADSREnvelope::ADSREnvelope() {
 
 void ADSREnvelope::setSampleRate(double newSampleRate) {
     sampleRate = newSampleRate;
-    internalADSR.setSampleRate(newSampleRate);
     updateRates();
 }
 
 void ADSREnvelope::setParameters(const Parameters& newParams) {
+    const StageCurve previousAttack = attackStage;
+    const StageCurve previousDecay = decayStage;
+    const StageCurve previousRelease = releaseStage;
+    const float previousSustain = sustainLevel;
+
     parameters = newParams;
-    updateRates();
+    if (!updateRates()) {
+        return;
+    }
+
+    // Only a new sustain level moves a held note; other changes retime the running stage
+    switch (currentState) {
+        case State::Attack:
+            retimeSegment(previousAttack, attackStage);
+            break;
+        case State::Decay:
+        case State::Sustain:
+            if (!juce::exactlyEqual(previousSustain, sustainLevel)) {
+                // Glide to the new sustain level instead of jumping
+                enterState(State::Decay);
+            } else if (currentState == State::Decay) {
+                retimeSegment(previousDecay, decayStage);
+            }
+            break;
+        case State::Release:
+            retimeSegment(previousRelease, releaseStage);
+            break;
+        case State::Idle:
+            break;
+    }
 }
 
 void ADSREnvelope::noteOn() {
-    noteIsOn = true;
-    currentState = State::Attack;
-    internalADSR.noteOn();
+    enterState(State::Attack);
 }
 
 void ADSREnvelope::noteOff() {
-    noteIsOn = false;
-    currentState = State::Release;
-    internalADSR.noteOff();
+    if (currentState != State::Idle) {
+        enterState(State::Release);
+    }
 }
 
-float ADSREnvelope::getNextSample() {
-    float sample = internalADSR.getNextSample();
-
-    // Update state based on envelope behavior
-    if (!isActive()) {
-        currentState = State::Idle;
-    } else if (noteIsOn) {
-        // Determine if we're in attack, decay, or sustain
-        static float lastSample = 0.0f;
-        float delta = sample - lastSample;
-        
-        if (sample < 0.99f && delta > 0.001f) {
-            currentState = State::Attack;
-        } else if (delta < -0.001f && sample > parameters.sustain + 0.1f) {
-            currentState = State::Decay;
-        } else if (std::abs(delta) < 0.001f) {
-            currentState = State::Sustain;
+void ADSREnvelope::renderBlock(float* output, int numSamples) {
+    int position = 0;
+
+    while (position < numSamples) {
+        if (currentState == State::Idle || currentState == State::Sustain) {
+            // Constant level until the next note event
+            juce::FloatVectorOperations::fill(output + position, value, numSamples - position);
+            return;
         }
-        
-        lastSample = sample;
-    }
 
-    return sample;
+        const int count = juce::jmin(segment.remaining, numSamples - position);
+        renderSegment(output + position, count);
+        position += count;
+        segment.remaining -= count;
+
+        if (segment.remaining == 0) {
+            // Land exactly on the end level and move to the next stage
+            value = segment.end;
+            output[position - 1] = value;
+            enterNextState();
+        }
+    }
 }
 
-bool ADSREnvelope::isActive() const {
-    return internalADSR.isActive();
+float ADSREnvelope::getNextSample() {
+    float sample = 0.0f;
+    renderBlock(&sample, 1);
+    return sample;
 }
 
 void ADSREnvelope::reset() {
-    internalADSR.reset();
     currentState = State::Idle;
-    noteIsOn = false;
+    value = 0.0f;
+    segment = {};
+}
+
+float ADSREnvelope::getCurveProgress(CurveShape shape, bool rising, float position) {
+    const double x = juce::jlimit(0.0, 1.0, static_cast<double>(position));
+    if (shape == CurveShape::Linear) {
+        return static_cast<float>(x);
+    }
+
+    // Closed form of the recursion used by renderSegment
+    const double ratio = getCurveRatio(shape);
+    const double decay = ratio / (1.0 + ratio);
+    const double progress = startsFast(shape, rising) ? (1.0 + ratio) * (1.0 - std::pow(decay, x))
+                                                      : ratio * (std::pow(1.0 / decay, x) - 1.0);
+    return static_cast<float>(juce::jlimit(0.0, 1.0, progress));
+}
+
+bool ADSREnvelope::updateRates() {
+    // Map our parameter range (0.0-1.0) to stage lengths
+    const auto toSamples = [this](float seconds) { return juce::roundToInt(seconds * sampleRate); };
+    const int attackSamples = toSamples(juce::jmap(parameters.attack, 0.0f, 1.0f, 0.01f, 3.0f));   // 0.01s to 3s
+    const int decaySamples = toSamples(juce::jmap(parameters.decay, 0.0f, 1.0f, 0.01f, 3.0f));     // 0.01s to 3s
+    const float newSustain = juce::jlimit(0.0f, 1.0f, parameters.sustain);                         // 0.0 to 1.0 (direct)
+    const int releaseSamples = toSamples(juce::jmap(parameters.release, 0.0f, 1.0f, 0.01f, 5.0f)); // 0.01s to 5s
+
+    const auto stageChanged = [](const StageCurve& stage, CurveShape shape, int length) {
+        return stage.shape != shape || stage.length != length;
+    };
+
+    const bool changed = stageChanged(attackStage, parameters.attackCurve, attackSamples)
+                         || stageChanged(decayStage, parameters.decayCurve, decaySamples)
+                         || stageChanged(releaseStage, parameters.releaseCurve, releaseSamples)
+                         || !juce::exactlyEqual(newSustain, sustainLevel);
+
+    // The curve coefficients only depend on shape and length, so they are computed here once
+    if (changed) {
+        attackStage = makeStageCurve(parameters.attackCurve, attackSamples);
+        decayStage = makeStageCurve(parameters.decayCurve, decaySamples);
+        releaseStage = makeStageCurve(parameters.releaseCurve, releaseSamples);
+        sustainLevel = newSustain;
+    }
+    return changed;
+}
+
+void ADSREnvelope::enterState(State newState) {
+    currentState = newState;
+
+    switch (newState) {
+        case State::Idle:
+            value = 0.0f;
+            return;
+
+        case State::Attack:
+            // A retriggered note rises from its current level, in proportion to the remaining height
+            startSegment(1.0f, attackStage,
+                         juce::roundToInt((1.0f - value) * static_cast<float>(attackStage.length)));
+            if (segment.remaining == 0) {
+                value = 1.0f;
+                enterState(State::Decay);
+            }
+            return;
+
+        case State::Decay:
+            startSegment(sustainLevel, decayStage, decayStage.length);
+            if (segment.remaining == 0) {
+                enterState(State::Sustain);
+            }
+            return;
+
+        case State::Sustain:
+            value = sustainLevel;
+            return;
+
+        case State::Release:
+            startSegment(0.0f, releaseStage, releaseStage.length);
+            if (segment.remaining == 0 || value <= 0.0f) {
+                enterState(State::Idle);
+            }
+            return;
+    }
+}
+
+void ADSREnvelope::enterNextState() {
+    switch (currentState) {
+        case State::Attack:  enterState(State::Decay); break;
+        case State::Decay:   enterState(State::Sustain); break;
+        case State::Release: enterState(State::Idle); break;
+        case State::Sustain:
+        case State::Idle:    break;
+    }
+}
+
+void ADSREnvelope::retimeSegment(const StageCurve& previous, const StageCurve& stage) {
+    if (previous.shape == stage.shape && previous.length == stage.length) {
+        return;
+    }
+
+    const int remaining = previous.length > 0
+                              ? juce::roundToInt(static_cast<double>(segment.remaining) * stage.length / previous.length)
+                              : 0;
+    startSegment(segment.end, stage, remaining);
+    if (segment.remaining == 0) {
+        enterNextState();
+    }
+}
+
+void ADSREnvelope::startSegment(float end, const StageCurve& stage, int numSamples) {
+    segment.end = end;
+    segment.remaining = juce::jmax(0, numSamples);
+
+    if (segment.remaining == 0) {
+        value = end;
+        return;
+    }
+
+    const double start = value;
+    const double height = end - start;
+
+    if (stage.shape == CurveShape::Linear || juce::exactlyEqual(height, 0.0)) {
+        segment.coefficient = 1.0;
+        segment.offset = height / segment.remaining;
+        return;
+    }
+
+    // value[n] = target + (start - target) * coefficient^n reaches end exactly at n = remaining
+    const double ratio = getCurveRatio(stage.shape);
+    double coefficient = segment.remaining == stage.length
+                             ? stage.coefficient
+                             : std::pow(ratio / (1.0 + ratio), 1.0 / segment.remaining);
+    double target = 0.0;
+
+    if (startsFast(stage.shape, height > 0.0)) {
+        target = end + ratio * height;
+    } else {
+        // Growing away from an asymptote behind the start level
+        coefficient = 1.0 / coefficient;
+        target = start - ratio * height;
+    }
+
+    segment.coefficient = coefficient;
+    segment.offset = target * (1.0 - coefficient);
 }
 
-void ADSREnvelope::updateRates() {
-    // Map our parameter range (0.0-1.0) to JUCE ADSR time ranges
-    juceParams.attack = juce::jmap(parameters.attack, 0.0f, 1.0f, 0.01f, 3.0f);     // 0.01s to 3s
-    juceParams.decay = juce::jmap(parameters.decay, 0.0f, 1.0f, 0.01f, 3.0f);       // 0.01s to 3s
-    juceParams.sustain = parameters.sustain;                                         // 0.0 to 1.0 (direct)
-    juceParams.release = juce::jmap(parameters.release, 0.0f, 1.0f, 0.01f, 5.0f);   // 0.01s to 5s
+void ADSREnvelope::renderSegment(float* output, int numSamples) {
+    // One multiply and one add per sample for every curve shape
+    const double coefficient = segment.coefficient;
+    const double offset = segment.offset;
+    double level = value;
+
+    for (int i = 0; i < numSamples; ++i) {
+        level = level * coefficient + offset;
+        output[i] = static_cast<float>(level);
+    }
+    value = static_cast<float>(level);
+}
 
-    internalADSR.setParameters(juceParams);
+double ADSREnvelope::getCurveRatio(CurveShape shape) {
+    return shape == CurveShape::AnalogRC ? analogRatio : exponentialRatio;
+}
+
+bool ADSREnvelope::startsFast(CurveShape shape, bool rising) {
+    switch (shape) {
+        case CurveShape::Exponential: return !rising;
+        case CurveShape::Logarithmic: return rising;
+        case CurveShape::AnalogRC:
+        case CurveShape::Linear:      return true;
+    }
+    return true;
+}
+
+ADSREnvelope::StageCurve ADSREnvelope::makeStageCurve(CurveShape shape, int length) {
+    StageCurve stage;
+    stage.shape = shape;
+    stage.length = length;
+
+    if (shape != CurveShape::Linear && length > 0) {
+        const double ratio = getCurveRatio(shape);
+        stage.coefficient = std::pow(ratio / (1.0 + ratio), 1.0 / length);
+    }
+    return stage;
 }
 
 // EffectsChain Implementation
@@ -163,17 +637,26 @@ void EffectsChain::prepare(double sampleRate, int maximumBlockSize, int numChann
     isPrepared = true;
 }
 
-void EffectsChain::processBlock(juce::AudioBuffer<float>& buffer, float reverbAmount, float bitCrushRate) {
+void EffectsChain::processBlock(juce::AudioBuffer<float>& buffer, float reverbAmount, float bitCrushRate,
+                                const float* reverbAmounts, const float* bitCrushRates) {
     if (!isPrepared) {
         return;
     }
 
     // Process reverb first
-    reverb.setAmount(reverbAmount);
-    reverb.processBlock(buffer);
+    if (reverbAmounts != nullptr) {
+        reverb.processBlock(buffer, reverbAmounts, reverbAmount);
+    } else {
+        reverb.setAmount(reverbAmount);
+        reverb.processBlock(buffer);
+    }
 
     // Then process bit crusher
-    bitCrusher.processBlock(buffer, bitCrushRate);
+    if (bitCrushRates != nullptr) {
+        bitCrusher.processBlock(buffer, bitCrushRates);
+    } else {
+        bitCrusher.processBlock(buffer, bitCrushRate);
+    }
 }
 
 void EffectsChain::reset() {
@@ -1,14 +1,35 @@
 #pragma once
 #include "JuceHeader.h"
 #include "juce_dsp/juce_dsp.h"
+#include "Utils.hpp"
+#include "FdnReverb.hpp"
+#include <atomic>
+#include <vector>
 
 /**
  * @file AudioEffects.hpp
  * @brief Audio effects implementations for the AvSynth audio plugin
  */
 
+/**
+ * @brief Reverb engine selection
+ */
+enum class ReverbMode {
+    Classic = 0,    ///< JUCE reverb (Freeverb: eight combs and four allpasses per channel)
+    Eco = 1,        ///< 8-line feedback delay network (cheapest)
+    Normal = 2,     ///< 16-line feedback delay network
+    High = 3,       ///< 16-line feedback delay network with two input diffusion steps (densest tail)
+    Convolution = 4 ///< Partitioned FFT convolution with a loaded impulse response
+};
+
 /**
  * @brief Reverb effect wrapper with simplified controls
+ *
+ * The wet signal comes from the JUCE reverb, a feedback delay network or a convolution with
+ * a loaded impulse response, depending on the mode. The engines run fully wet; the wet/dry mix is applied here with per-sample gains.
+ * Only the selected engine is reconfigured, and only when the amount actually changes. When the
+ * amount drops to zero, the reverb stops taking input and its tail fades out; after that
+ * the reverb is cleared and bypassed until the amount rises again.
  */
 class ReverbEffect {
 public:
@@ -23,7 +44,7 @@ public:
     ~ReverbEffect() = default;
 
     /**
-     * @brief Prepare the reverb for processing
+     * @brief Prepare the reverb for processing (allocates, call from prepareToPlay only)
      * @param sampleRate Sample rate in Hz
      * @param maximumBlockSize Maximum expected block size
      * @param numChannels Number of audio channels
@@ -32,10 +53,26 @@ public:
 
     /**
      * @brief Process audio block with reverb
+     *
+     * Amount changes made with setAmount() are ramped over the block.
      * @param buffer Audio buffer to process
      */
     void processBlock(juce::AudioBuffer<float>& buffer);
 
+    /**
+     * @brief Process audio block with a changing reverb amount
+     *
+     * The wet/dry mix follows the amounts per sample. Room size and damping follow them every
+     * SmoothedParameter::controlBlockSize samples. While the amounts ramp to zero, only the dry
+     * gain follows them; the reverb stops taking input and its tail fades out as with setAmount().
+     * If the amounts rise again during the fade, the wet gain crossfades from the faded gain to the
+     * amounts over the wet/dry ramp time instead of jumping to them.
+     * @param buffer Audio buffer to process
+     * @param amounts Reverb amount of every sample in the buffer
+     * @param targetAmount Amount the ramp is heading to
+     */
+    void processBlock(juce::AudioBuffer<float>& buffer, const float* amounts, float targetAmount);
+
     /**
      * @brief Set reverb amount
      * @param amount Reverb amount (0.0 to 1.0)
@@ -48,6 +85,46 @@ public:
      */
     float getAmount() const { return currentAmount; }
 
+    /**
+     * @brief Select the reverb engine (the tail of the previous engine is dropped)
+     * @param newMode Reverb mode
+     */
+    void setMode(ReverbMode newMode);
+
+    /**
+     * @brief Get the selected reverb engine
+     * @return Reverb mode
+     */
+    ReverbMode getMode() const { return mode; }
+
+    /**
+     * @brief Hand a new impulse response to the convolution engine (any thread but the audio thread)
+     *
+     * The engine resamples and partitions it on its own background thread and swaps it in
+     * with a short crossfade; the audio thread never waits for it. Until the first impulse
+     * response is active, the convolution mode outputs no wet signal.
+     * @param impulseResponse Impulse response (one or two channels)
+     * @param sampleRate Sample rate of the impulse response in Hz
+     */
+    void loadImpulseResponse(juce::AudioBuffer<float>&& impulseResponse, double sampleRate);
+
+    /**
+     * @brief Get how long the reverb keeps sounding after its input stops (any thread)
+     *
+     * The decay time of the engine in the algorithmic modes, the length of the last impulse
+     * response (after trimming) in the convolution mode.
+     * @param reverbMode Reverb engine
+     * @param amount Reverb amount (0.0 to 1.0)
+     * @return Tail length in seconds (0 if the reverb is off)
+     */
+    double getTailLengthSeconds(ReverbMode reverbMode, float amount) const;
+
+    /**
+     * @brief Check if the reverb is bypassed (amount zero and tail faded out)
+     * @return True if processing costs nothing
+     */
+    bool isIdle() const { return wetGain.isSettled() && wetGain.getCurrent() <= 0.0f && dryGain.isSettled(); }
+
     /**
      * @brief Reset the reverb state
      */
@@ -55,14 +132,74 @@ public:
 
 private:
     /**
-     * @brief Update internal reverb parameters based on amount
+     * @brief Configure the selected engine if the amount changed since the last update
+     * @param amount Reverb amount the room size and damping are derived from
      */
-    void updateParameters();
+    void updateParameters(float amount);
 
-    juce::dsp::Reverb reverb;           ///< Internal JUCE reverb processor
-    juce::dsp::ProcessSpec spec;        ///< Processing specification
-    float currentAmount = 0.0f;         ///< Current reverb amount
-    bool isPrepared = false;            ///< Preparation state flag
+    /**
+     * @brief Get the decay time of the delay networks for an amount
+     * @param amount Reverb amount (0.0 to 1.0)
+     * @return Time for the tail to fall by 60 dB, in seconds
+     */
+    static float getNetworkDecaySeconds(float amount);
+
+    /**
+     * @brief Run the reverb on a part of a chunk into the same part of the wet buffer
+     * @param buffer Input audio
+     * @param chunkStart First sample of the chunk in the buffer
+     * @param offset First sample to process within the chunk
+     * @param numSamples Number of samples (offset + numSamples at most the wet buffer size)
+     * @param takeInput False to feed silence, so only the tail is rendered
+     */
+    void renderWet(const juce::AudioBuffer<float>& buffer, int chunkStart, int offset, int numSamples,
+                   bool takeInput);
+
+    /**
+     * @brief Mix the wet buffer into a part of the buffer with the per-sample gains
+     * @param buffer Audio buffer to mix into
+     * @param startSample First sample to mix
+     * @param numSamples Number of samples (at most the wet buffer size)
+     */
+    void mixWet(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    /**
+     * @brief Clear the reverb once its tail has faded out
+     */
+    void finishTail();
+
+    /**
+     * @brief Clear the state of all engines
+     */
+    void clearEngines();
+
+    static constexpr float wetScale = 1.2f;          ///< Wet gain at full amount
+    static constexpr float dryReduction = 0.3f;      ///< Dry gain reduction at full amount (dry stays dominant)
+    static constexpr double gainRampSeconds = 0.02;  ///< Wet/dry ramp time for amount changes
+    static constexpr double tailFadeSeconds = 0.3;   ///< Wet fade-out time when the reverb is switched off
+    static constexpr int convolutionHeadSize = 256;  ///< Size of the short low-latency partitions at the start of the IR
+
+    juce::dsp::Reverb reverb;                ///< Internal JUCE reverb processor (fully wet)
+    FeedbackDelayNetwork<8> ecoNetwork;      ///< Engine of ReverbMode::Eco
+    FeedbackDelayNetwork<16> normalNetwork;  ///< Engine of ReverbMode::Normal
+    FeedbackDelayNetwork<16, 2> highNetwork; ///< Engine of ReverbMode::High
+    juce::dsp::Convolution convolution{juce::dsp::Convolution::NonUniform{convolutionHeadSize}}; ///< Engine of ReverbMode::Convolution
+    std::atomic<double> impulseResponseSeconds{0.0}; ///< Length of the last impulse response handed to the convolution
+    ReverbMode mode = ReverbMode::Classic;   ///< Selected engine
+    juce::dsp::ProcessSpec spec;             ///< Processing specification
+    juce::AudioBuffer<float> wetBuffer;      ///< Reverb output of the current chunk
+    std::vector<float> wetGains;             ///< Wet gain of every sample of the current chunk
+    std::vector<float> dryGains;             ///< Dry gain of every sample of the current chunk
+    LinearRamp<float> wetGain;               ///< Wet gain ramp for setAmount() changes
+    LinearRamp<float> dryGain;               ///< Dry gain ramp for setAmount() changes
+    LinearRamp<float> wetCrossfade;          ///< Blend from crossfadeStartGain to the per-sample wet gain (0 to 1)
+    float crossfadeStartGain = 0.0f;         ///< Wet gain of the interrupted tail fade
+    float currentAmount = 0.0f;              ///< Current reverb amount
+    float configuredAmount = -1.0f;          ///< Amount the selected engine was configured for
+    int gainRampSamples = 0;                 ///< Wet/dry ramp length in samples
+    int tailFadeSamples = 0;                 ///< Tail fade-out length in samples
+    bool isPrepared = false;                 ///< Preparation state flag
+    bool impulseResponseActive = false;      ///< The convolution runs a loaded impulse response
 };
 
 /**
@@ -87,6 +224,13 @@ public:
      */
     void processBlock(juce::AudioBuffer<float>& buffer, float rate);
 
+    /**
+     * @brief Process audio buffer with a changing bit crush rate
+     * @param buffer Audio buffer to process
+     * @param rates Bit crush rate of every sample in the buffer (1.0 = no effect)
+     */
+    void processBlock(juce::AudioBuffer<float>& buffer, const float* rates);
+
     /**
      * @brief Process a single sample with bit crushing
      * @param sample Input sample
@@ -113,9 +257,25 @@ private:
 
 /**
  * @brief ADSR envelope generator
+ *
+ * Renders blocks of gain values. Every stage is a segment with a known length in samples,
+ * so the state is always exact: each segment lands on its end level exactly when it ends.
+ * Attack, decay and release have selectable curve shapes, all computed with the same
+ * one-multiply-one-add recursion, so curved stages cost as much as linear ones.
+ * All state is per instance.
  */
 class ADSREnvelope {
 public:
+    /**
+     * @brief Curve shape of a time stage
+     */
+    enum class CurveShape {
+        Linear = 0,      ///< Straight line
+        Exponential = 1, ///< Linear in decibels: rises slowly and accelerates, falls fast with a long tail
+        Logarithmic = 2, ///< Mirror of exponential: rises fast and levels off, falls slowly and drops at the end
+        AnalogRC = 3     ///< Capacitor charging towards a target beyond the end level (gentle curve)
+    };
+
     /**
      * @brief ADSR parameters structure
      */
@@ -124,6 +284,9 @@ public:
         float decay = 0.3f;    ///< Decay time in seconds
         float sustain = 0.7f;  ///< Sustain level (0.0 to 1.0)
         float release = 0.5f;  ///< Release time in seconds
+        CurveShape attackCurve = CurveShape::Linear;  ///< Attack curve shape
+        CurveShape decayCurve = CurveShape::Linear;   ///< Decay curve shape
+        CurveShape releaseCurve = CurveShape::Linear; ///< Release curve shape
 
         /**
          * @brief Constructor with default values
@@ -136,9 +299,14 @@ public:
          * @param dec Decay time
          * @param sust Sustain level
          * @param rel Release time
+         * @param attCurve Attack curve shape
+         * @param decCurve Decay curve shape
+         * @param relCurve Release curve shape
          */
-        Parameters(float att, float dec, float sust, float rel)
-            : attack(att), decay(dec), sustain(sust), release(rel) {}
+        Parameters(float att, float dec, float sust, float rel, CurveShape attCurve = CurveShape::Linear,
+                   CurveShape decCurve = CurveShape::Linear, CurveShape relCurve = CurveShape::Linear)
+            : attack(att), decay(dec), sustain(sust), release(rel),
+              attackCurve(attCurve), decayCurve(decCurve), releaseCurve(relCurve) {}
     };
 
     /**
@@ -170,6 +338,9 @@ public:
 
     /**
      * @brief Set ADSR parameters
+     *
+     * A new sustain level glides there through the decay stage. Other changes only retime the
+     * rest of the running stage, so a held note is not disturbed by the release settings.
      * @param params ADSR parameters
      */
     void setParameters(const Parameters& params);
@@ -181,26 +352,39 @@ public:
     const Parameters& getParameters() const { return parameters; }
 
     /**
-     * @brief Trigger note on (start attack phase)
+     * @brief Trigger note on (start attack phase from the current level)
      */
     void noteOn();
 
     /**
-     * @brief Trigger note off (start release phase)
+     * @brief Trigger note off (start release phase from the current level)
      */
     void noteOff();
 
+    /**
+     * @brief Render a block of envelope values
+     * @param output Buffer receiving the envelope values (0.0 to 1.0)
+     * @param numSamples Number of samples to render
+     */
+    void renderBlock(float* output, int numSamples);
+
     /**
      * @brief Get next envelope sample
      * @return Envelope value (0.0 to 1.0)
      */
     float getNextSample();
 
+    /**
+     * @brief Get the envelope value of the last rendered sample
+     * @return Envelope value (0.0 to 1.0)
+     */
+    float getCurrentValue() const { return value; }
+
     /**
      * @brief Check if envelope is active
      * @return True if envelope is producing output
      */
-    bool isActive() const;
+    bool isActive() const { return currentState != State::Idle; }
 
     /**
      * @brief Get current envelope state
@@ -213,18 +397,115 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Evaluate a curve shape (used to draw the envelope)
+     * @param shape Curve shape
+     * @param rising True if the stage rises (attack), false if it falls
+     * @param position Position within the stage (0.0 to 1.0)
+     * @return Fraction of the stage height covered at this position (0.0 to 1.0)
+     */
+    static float getCurveProgress(CurveShape shape, bool rising, float position);
+
 private:
+    /**
+     * @brief Curve of a time stage, precomputed for its full length
+     */
+    struct StageCurve {
+        CurveShape shape = CurveShape::Linear; ///< Curve shape
+        int length = 0;                        ///< Stage length in samples
+        double coefficient = 1.0;              ///< Per-sample multiplier of the fast-start form over the full length
+    };
+
+    /**
+     * @brief One envelope stage moving towards an end level in a fixed number of samples
+     *
+     * Every shape is value = value * coefficient + offset. Linear segments use a coefficient
+     * of 1; curved ones move towards (or away from) an asymptote just outside the segment.
+     */
+    struct Segment {
+        float end = 0.0f;          ///< Level reached when the segment is over
+        double coefficient = 1.0;  ///< Per-sample multiplier
+        double offset = 0.0;       ///< Per-sample addend
+        int remaining = 0;         ///< Samples until the segment is over
+    };
+
     /**
      * @brief Update internal rate calculations when parameters change
+     * @return True if any stage length or the sustain level changed
+     */
+    bool updateRates();
+
+    /**
+     * @brief Switch to a state and set up its segment from the current level
+     * @param newState State to enter
      */
-    void updateRates();
+    void enterState(State newState);
 
-    juce::ADSR internalADSR;        ///< Internal JUCE ADSR
-    juce::ADSR::Parameters juceParams; ///< JUCE ADSR parameters
-    Parameters parameters;          ///< Our parameter structure
+    /**
+     * @brief Enter the state that follows the current one once its segment is over
+     */
+    void enterNextState();
+
+    /**
+     * @brief Continue the running segment with a changed stage curve
+     *
+     * The rest of the segment keeps its share of the stage, so the level carries on from
+     * where it is and reaches the same end level; the state is not changed.
+     * @param previous Stage curve the segment was started with
+     * @param stage New stage curve
+     */
+    void retimeSegment(const StageCurve& previous, const StageCurve& stage);
+
+    /**
+     * @brief Start a segment from the current level
+     * @param end Level to reach
+     * @param stage Curve of the stage the segment belongs to
+     * @param numSamples Segment length in samples (may be shorter than the stage)
+     */
+    void startSegment(float end, const StageCurve& stage, int numSamples);
+
+    /**
+     * @brief Get the asymptote distance of a curve shape
+     * @param shape Curved shape (not Linear)
+     * @return Asymptote distance beyond the segment, relative to the segment height
+     */
+    static double getCurveRatio(CurveShape shape);
+
+    /**
+     * @brief Check if a curve starts fast and levels off into the end level
+     * @param shape Curved shape (not Linear)
+     * @param rising True if the segment rises
+     * @return True for a fast start, false for a slow start that accelerates
+     */
+    static bool startsFast(CurveShape shape, bool rising);
+
+    /**
+     * @brief Precompute the curve of a time stage
+     * @param shape Curve shape
+     * @param length Stage length in samples
+     * @return Stage curve
+     */
+    static StageCurve makeStageCurve(CurveShape shape, int length);
+
+    /**
+     * @brief Render part of the current segment
+     * @param output Buffer receiving the envelope values
+     * @param numSamples Number of samples to render (at most segment.remaining)
+     */
+    void renderSegment(float* output, int numSamples);
+
+    static constexpr double exponentialRatio = 0.01; ///< Asymptote distance of exponential and logarithmic curves
+    static constexpr double analogRatio = 0.3;       ///< Asymptote distance of the RC curve
+
+    Parameters parameters;            ///< Our parameter structure
     State currentState = State::Idle; ///< Current envelope state
-    double sampleRate = 44100.0;    ///< Current sample rate
-    bool noteIsOn = false;          ///< Note on/off state
+    Segment segment;                  ///< Segment of the current state (unused in Idle and Sustain)
+    double sampleRate = 44100.0;      ///< Current sample rate
+    StageCurve attackStage;           ///< Attack length and curve
+    StageCurve decayStage;            ///< Decay length and curve
+    StageCurve releaseStage;          ///< Release length and curve
+    float sustainLevel = 0.7f;        ///< Sustain level
+    float value = 0.0f;               ///< Envelope value of the last rendered sample
 };
 
 /**
@@ -253,10 +534,13 @@ public:
     /**
      * @brief Process audio buffer through the effects chain
      * @param buffer Audio buffer to process
-     * @param reverbAmount Reverb effect amount
+     * @param reverbAmount Reverb effect amount (the target of reverbAmounts while they ramp)
      * @param bitCrushRate Bit crusher rate
+     * @param reverbAmounts Per-sample reverb amounts, or nullptr if reverbAmount holds for the whole block
+     * @param bitCrushRates Per-sample bit crusher rates, or nullptr if bitCrushRate holds for the whole block
      */
-    void processBlock(juce::AudioBuffer<float>& buffer, float reverbAmount, float bitCrushRate);
+    void processBlock(juce::AudioBuffer<float>& buffer, float reverbAmount, float bitCrushRate,
+                      const float* reverbAmounts = nullptr, const float* bitCrushRates = nullptr);
 
     /**
      * @brief Get reverb effect reference
@@ -264,6 +548,8 @@ public:
      */
     ReverbEffect& getReverb() { return reverb; }
 
+    const ReverbEffect& getReverb() const { return reverb; }
+
     /**
      * @brief Get bit crusher effect reference
      * @return Reference to bit crusher effect
@@ -0,0 +1,233 @@
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include "JuceHeader.h"
+
+/**
+ * @file FastMath.hpp
+ * @brief Polynomial approximations of transcendental functions for audio-rate code
+ *
+ * The templated functions accept a float or a juce::dsp::SIMDRegister<float>, so the
+ * same code runs in scalar loops and in SIMD voice kernels. Error bounds are given
+ * for float evaluation and were measured against the std:: versions over the stated range.
+ */
+
+namespace FastMath {
+    namespace detail {
+        /**
+         * @brief Check if a sample type is a plain floating point value
+         */
+        template <typename T>
+        constexpr bool isScalar = std::is_floating_point_v<T>;
+
+        /**
+         * @brief Broadcast a constant to the sample type
+         * @param value Constant value
+         * @return value as T
+         */
+        template <typename T>
+        forcedinline T constant(float value) noexcept {
+            if constexpr (isScalar<T>) {
+                return static_cast<T>(value);
+            } else {
+                return T::expand(value);
+            }
+        }
+
+        /**
+         * @brief Absolute value
+         * @param x Input value
+         * @return |x|
+         */
+        template <typename T>
+        forcedinline T abs(T x) noexcept {
+            if constexpr (isScalar<T>) {
+                return std::abs(x);
+            } else {
+                return T::abs(x);
+            }
+        }
+
+        /**
+         * @brief Round towards negative infinity
+         * @param x Input value (|x| < 2^31)
+         * @return Largest integer value not greater than x
+         */
+        template <typename T>
+        forcedinline T floor(T x) noexcept {
+            if constexpr (isScalar<T>) {
+                // Truncation is a single instruction, std::floor may be a library call. The
+                // correction is done in integers, so loops over this stay vectorizable.
+                const auto truncated = static_cast<std::int32_t>(x);
+                return static_cast<T>(truncated - static_cast<std::int32_t>(static_cast<T>(truncated) > x));
+            } else {
+                const T truncated = T::truncate(x);
+                return truncated - (T::expand(1.0f) & T::greaterThan(truncated, x));
+            }
+        }
+
+        /**
+         * @brief Clamp a value to a range
+         * @param x Input value
+         * @param lower Lower limit
+         * @param upper Upper limit
+         * @return Clamped value
+         */
+        template <typename T>
+        forcedinline T clamp(T x, float lower, float upper) noexcept {
+            if constexpr (isScalar<T>) {
+                return juce::jlimit(static_cast<T>(lower), static_cast<T>(upper), x);
+            } else {
+                return T::min(T::max(x, T::expand(lower)), T::expand(upper));
+            }
+        }
+
+        /**
+         * @brief Divide two values (SIMDRegister has no division, so lanes are divided one by one)
+         * @param numerator Numerator
+         * @param denominator Denominator
+         * @return numerator / denominator
+         */
+        template <typename T>
+        forcedinline T divide(T numerator, T denominator) noexcept {
+            if constexpr (isScalar<T>) {
+                return numerator / denominator;
+            } else {
+                alignas(T::SIMDRegisterSize) float n[T::SIMDNumElements];
+                alignas(T::SIMDRegisterSize) float d[T::SIMDNumElements];
+                numerator.copyToRawArray(n);
+                denominator.copyToRawArray(d);
+                for (size_t i = 0; i < T::SIMDNumElements; ++i) {
+                    n[i] /= d[i];
+                }
+                return T::fromRawArray(n);
+            }
+        }
+    }
+
+    /**
+     * @brief Sine of a normalized phase, sin(2 * pi * phase)
+     *
+     * Max absolute error 4.1e-7 for phases in [0, 1) and 3e-6 for |phase| < 10; beyond that
+     * the float resolution of the phase itself dominates.
+     * @param phase Phase in cycles (|phase| < 2^31)
+     * @return Sine value
+     */
+    template <typename T>
+    forcedinline T sinCycle(T phase) noexcept {
+        // Fold into a quarter cycle around zero: sin(2*pi*u) == sin(2*pi*(0.25 - |u - 0.25|)) for u in [-0.25, 0.75)
+        const T shifted = phase + 0.25f;
+        const T u = shifted - detail::floor(shifted) - 0.25f;
+        const T x = (detail::constant<T>(0.25f) - detail::abs(u - 0.25f)) * juce::MathConstants<float>::twoPi;
+
+        // Odd near-minimax polynomial on [-pi/2, pi/2]
+        const T x2 = x * x;
+        return x * ((((x2 * 2.6051076e-6f - 1.9809017e-4f) * x2 + 8.3330502e-3f) * x2 - 1.6666658e-1f) * x2 + 9.9999999e-1f);
+    }
+
+    /**
+     * @brief Sine of an angle in radians
+     *
+     * Max absolute error 8.2e-7 for |x| < 2 * pi, 2e-6 for |x| < 20 and 1.2e-4 for |x| < 1000;
+     * the error grows with |x| because x / (2 * pi) is rounded to float.
+     * @param x Angle in radians (|x| < 1e9)
+     * @return Sine value
+     */
+    template <typename T>
+    forcedinline T sin(T x) noexcept {
+        return sinCycle(x * (1.0f / juce::MathConstants<float>::twoPi));
+    }
+
+    /**
+     * @brief Hyperbolic tangent ([9/8] Pade approximant from the continued fraction of tanh)
+     *
+     * Max absolute error 7e-6; the input is clamped to +-7 where tanh is 1 within that error.
+     * @param x Input value (any value)
+     * @return tanh(x)
+     */
+    template <typename T>
+    forcedinline T tanh(T x) noexcept {
+        x = detail::clamp(x, -7.0f, 7.0f);
+        const T x2 = x * x;
+        const T numerator = x * ((((x2 + 990.0f) * x2 + 135135.0f) * x2 + 4729725.0f) * x2 + 34459425.0f);
+        const T denominator = (((x2 * 45.0f + 13860.0f) * x2 + 945945.0f) * x2 + 16216200.0f) * x2 + 34459425.0f;
+        return detail::clamp(detail::divide(numerator, denominator), -1.0f, 1.0f);
+    }
+
+    /**
+     * @brief Round to the nearest integer, halfway cases away from zero (like std::round)
+     *
+     * Exact for |x| < 2^31. The fraction is compared instead of adding 0.5 before truncating,
+     * because that sum rounds up for 0.49999997 and for odd values of 2^23 and above.
+     * @param x Input value (|x| < 2^31)
+     * @return Rounded value
+     */
+    template <typename T>
+    forcedinline T round(T x) noexcept {
+        if constexpr (detail::isScalar<T>) {
+            // x minus its truncation is exact; the correction is done in integers so loops vectorize
+            const auto truncated = static_cast<std::int32_t>(x);
+            const T fraction = x - static_cast<T>(truncated);
+            return static_cast<T>(truncated + static_cast<std::int32_t>(fraction >= 0.5f)
+                                  - static_cast<std::int32_t>(fraction <= -0.5f));
+        } else {
+            const T truncated = T::truncate(x);
+            const T fraction = x - truncated;
+            const T one = T::expand(1.0f);
+            return truncated + (one & T::greaterThanOrEqual(fraction, T::expand(0.5f)))
+                   - (one & T::lessThanOrEqual(fraction, T::expand(-0.5f)));
+        }
+    }
+
+    /**
+     * @brief Base-2 exponential
+     *
+     * Max relative error 1.8e-7 for x in [-126, 128).
+     * @param x Exponent
+     * @return 2^x
+     */
+    inline float exp2(float x) noexcept {
+        x = juce::jlimit(-126.0f, 127.99999f, x); // Largest float below 128, so the exponent stays finite
+        const float integerPart = detail::floor(x);
+        const float f = x - integerPart;
+
+        // Near-minimax polynomial for 2^f on [0, 1)
+        const float mantissa = ((((1.8937541e-3f * f + 8.9495904e-3f) * f + 5.5860337e-2f) * f + 2.4014182e-1f) * f
+                                + 6.9315449e-1f) * f + 9.9999990e-1f;
+        const auto exponent = static_cast<std::uint32_t>(static_cast<std::int32_t>(integerPart) + 127) << 23;
+        return mantissa * std::bit_cast<float>(exponent);
+    }
+
+    /**
+     * @brief Base-2 logarithm
+     *
+     * Max absolute error 3e-6 for x in [2^-16, 2^16] and 1.1e-5 for all positive normal inputs;
+     * outside [2^-16, 2^16] the float resolution of the result dominates.
+     * @param x Input value (must be > 0)
+     * @return log2(x)
+     */
+    inline float log2(float x) noexcept {
+        const auto bits = std::bit_cast<std::uint32_t>(x);
+        const auto exponent = static_cast<float>(static_cast<std::int32_t>((bits >> 23) & 0xffu) - 127);
+        const float u = std::bit_cast<float>((bits & 0x7fffffu) | 0x3f800000u) - 1.0f;
+
+        // Near-minimax polynomial for log2(1 + u) on [0, 1)
+        const float mantissa = (((((-2.4568535e-2f * u + 1.1761308e-1f) * u - 2.7269756e-1f) * u + 4.5450849e-1f) * u
+                                 - 7.1731278e-1f) * u + 1.4424535f) * u + 2.4434387e-6f;
+        return exponent + mantissa;
+    }
+
+    /**
+     * @brief Power function for positive bases, computed as 2^(exponent * log2(base))
+     *
+     * Relative error grows with |exponent * log2(base)|; below 1e-5 for results in [1e-6, 1e6].
+     * @param base Base (must be > 0; 0 is returned otherwise)
+     * @param exponent Exponent
+     * @return base^exponent
+     */
+    inline float pow(float base, float exponent) noexcept {
+        return base > 0.0f ? exp2(exponent * log2(base)) : 0.0f;
+    }
+}
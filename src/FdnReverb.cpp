@@ -0,0 +1,206 @@
+#include "FdnReverb.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /// Delay lengths at 44.1 kHz (primes spread geometrically from 23 ms to 104 ms)
+    constexpr std::array<int, 16> baseLengths{1009, 1123, 1249, 1381, 1531, 1693, 1871, 2069,
+                                              2287, 2531, 2797, 3089, 3413, 3769, 4159, 4591};
+
+    /// Diffusion delays at 44.1 kHz (primes spread evenly up to 20 ms and 10 ms, in bit-reversed order)
+    constexpr std::array<std::array<int, 16>, 2> baseDiffusionLengths{{
+        {53, 499, 277, 719, 163, 607, 383, 827, 109, 547, 331, 773, 223, 661, 439, 881},
+        {29, 251, 137, 359, 83, 307, 193, 409, 53, 277, 163, 383, 109, 331, 223, 439}}};
+
+    /// Lines whose polarity a diffusion step flips (bit n set for line n)
+    constexpr std::array<juce::uint32, 2> diffusionFlips{0x6c93u, 0xa53cu};
+
+    constexpr float inputGain = 0.25f;  ///< Input level fed into every line
+    constexpr float outputGain = 0.5f;  ///< Output level before the per-size normalization
+}
+
+// FeedbackDelayNetwork Implementation
+template <size_t NumLines, size_t DiffusionSteps>
+void FeedbackDelayNetwork<NumLines, DiffusionSteps>::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+
+    // Smaller networks take every n-th length, so they span the same range
+    constexpr size_t step = baseLengths.size() / NumLines;
+    const double scale = sampleRate / 44100.0;
+    for (size_t line = 0; line < NumLines; ++line) {
+        lengths[line] = juce::jmax(1, juce::roundToInt(baseLengths[line * step + step / 2] * scale));
+    }
+
+    const int bufferLength = juce::nextPowerOfTwo(*std::max_element(lengths.begin(), lengths.end()) + 1);
+    bufferMask = bufferLength - 1;
+    delayBuffer.assign(static_cast<size_t>(bufferLength) * numRegisters, SIMDFloat::expand(0.0f));
+
+    // Every diffusion step is orthogonal: the Hadamard normalization with a sign per line
+    const float normalization = 1.0f / std::sqrt(static_cast<float>(NumLines));
+    for (size_t diffusionStep = 0; diffusionStep < DiffusionSteps; ++diffusionStep) {
+        auto& stepLengths = diffusionLengths[diffusionStep];
+        std::array<float, NumLines> gains{};
+        for (size_t line = 0; line < NumLines; ++line) {
+            stepLengths[line] = juce::jmax(1, juce::roundToInt(baseDiffusionLengths[diffusionStep][line * step] * scale));
+            gains[line] = ((diffusionFlips[diffusionStep] >> line) & 1u) != 0 ? -normalization : normalization;
+        }
+        diffusionGains[diffusionStep] = toFrame(gains);
+
+        // Not longer than the network buffer, so the network's write index wraps every diffusion buffer too
+        const int diffusionLength = juce::nextPowerOfTwo(*std::max_element(stepLengths.begin(), stepLengths.end()) + 1);
+        jassert(diffusionLength <= bufferLength);
+        diffusionMasks[diffusionStep] = diffusionLength - 1;
+        diffusionBuffers[diffusionStep].assign(static_cast<size_t>(diffusionLength) * numRegisters, SIMDFloat::expand(0.0f));
+    }
+
+    // Even lines take the left input, odd lines the right
+    std::array<float, NumLines> left{};
+    std::array<float, NumLines> right{};
+    for (size_t line = 0; line < NumLines; line += 2) {
+        left[line] = inputGain;
+        right[line + 1] = inputGain;
+    }
+    leftInput = toFrame(left)[0];
+    rightInput = toFrame(right)[0];
+
+    reset();
+}
+
+template <size_t NumLines, size_t DiffusionSteps>
+void FeedbackDelayNetwork<NumLines, DiffusionSteps>::setParameters(float decaySeconds, float newDamping) {
+    // Every line loses 60 dB over decaySeconds, independent of its length; the Hadamard
+    // normalization is folded into the gains so the mixing itself needs no multiply
+    const double samplesToSilence = juce::jmax(0.01, static_cast<double>(decaySeconds)) * sampleRate;
+    const double normalization = 1.0 / std::sqrt(static_cast<double>(NumLines));
+    std::array<float, NumLines> gains{};
+    for (size_t line = 0; line < NumLines; ++line) {
+        gains[line] = static_cast<float>(std::pow(10.0, -3.0 * lengths[line] / samplesToSilence) * normalization);
+    }
+    feedback = toFrame(gains);
+
+    damping = juce::jlimit(0.0f, 0.99f, newDamping);
+}
+
+template <size_t NumLines, size_t DiffusionSteps>
+void FeedbackDelayNetwork<NumLines, DiffusionSteps>::process(float* left, float* right, int numSamples) noexcept {
+    if (delayBuffer.empty()) {
+        return;
+    }
+
+    const float outputScale = outputGain / std::sqrt(static_cast<float>(NumLines / 2));
+    alignas(SIMDFloat::SIMDRegisterSize) float lanes[NumLines];
+
+    for (int i = 0; i < numSamples; ++i) {
+        const float inLeft = left[i];
+        const float inRight = right != nullptr ? right[i] : left[i];
+        const SIMDFloat input = leftInput * inLeft + rightInput * inRight;
+
+        Frame mixed;
+        readLines(delayBuffer, lengths, writeIndex, bufferMask, lanes);
+        hadamard(lanes, mixed);
+
+        // Rows 0 and 1 of the Hadamard matrix sum all lines and subtract the odd from the even
+        // lines, so the even (left) and odd (right) output sums come with the mixing for free
+        const float sumAll = mixed[0].get(0);
+        const float evenMinusOdd = mixed[0].get(1);
+
+        // Spread the input over all lines through the diffusion steps
+        Frame injected;
+        injected.fill(input);
+        for (size_t diffusionStep = 0; diffusionStep < DiffusionSteps; ++diffusionStep) {
+            auto& buffer = diffusionBuffers[diffusionStep];
+            const int index = writeIndex & diffusionMasks[diffusionStep];
+            std::copy(injected.begin(), injected.end(), buffer.begin() + index * static_cast<int>(numRegisters));
+
+            readLines(buffer, diffusionLengths[diffusionStep], index, diffusionMasks[diffusionStep], lanes);
+            hadamard(lanes, injected);
+            for (size_t reg = 0; reg < numRegisters; ++reg) {
+                injected[reg] *= diffusionGains[diffusionStep][reg];
+            }
+        }
+
+        // Damping, decay and the input, one register at a time, written as the new frame
+        SIMDFloat* writeFrame = delayBuffer.data() + static_cast<size_t>(writeIndex) * numRegisters;
+        for (size_t reg = 0; reg < numRegisters; ++reg) {
+            lowpass[reg] = mixed[reg] + (lowpass[reg] - mixed[reg]) * damping;
+            writeFrame[reg] = lowpass[reg] * feedback[reg] + injected[reg];
+        }
+        writeIndex = (writeIndex + 1) & bufferMask;
+
+        left[i] = 0.5f * (sumAll + evenMinusOdd) * outputScale;
+        if (right != nullptr) {
+            right[i] = 0.5f * (sumAll - evenMinusOdd) * outputScale;
+        }
+    }
+}
+
+template <size_t NumLines, size_t DiffusionSteps>
+void FeedbackDelayNetwork<NumLines, DiffusionSteps>::reset() {
+    std::fill(delayBuffer.begin(), delayBuffer.end(), SIMDFloat::expand(0.0f));
+    for (auto& buffer : diffusionBuffers) {
+        std::fill(buffer.begin(), buffer.end(), SIMDFloat::expand(0.0f));
+    }
+    lowpass.fill(SIMDFloat::expand(0.0f));
+    writeIndex = 0;
+}
+
+template <size_t NumLines, size_t DiffusionSteps>
+void FeedbackDelayNetwork<NumLines, DiffusionSteps>::hadamard(float* lanes, Frame& frame) noexcept {
+    // Fast Walsh-Hadamard transform: log2(NumLines) butterfly stages instead of a matrix multiply.
+    // The stages act on separate index bits, so their order is free. Butterflies within a register
+    // would need lane shuffles, which SIMDRegister does not offer, so they run before loading.
+    for (size_t half = 1; half < numLanes; half *= 2) {
+        for (size_t start = 0; start < NumLines; start += 2 * half) {
+            for (size_t k = start; k < start + half; ++k) {
+                const float a = lanes[k];
+                const float b = lanes[k + half];
+                lanes[k] = a + b;
+                lanes[k + half] = a - b;
+            }
+        }
+    }
+
+    for (size_t reg = 0; reg < numRegisters; ++reg) {
+        frame[reg] = SIMDFloat::fromRawArray(lanes + reg * numLanes);
+    }
+
+    // Butterflies between registers
+    for (size_t half = 1; half < numRegisters; half *= 2) {
+        for (size_t start = 0; start < numRegisters; start += 2 * half) {
+            for (size_t k = start; k < start + half; ++k) {
+                const SIMDFloat a = frame[k];
+                const SIMDFloat b = frame[k + half];
+                frame[k] = a + b;
+                frame[k + half] = a - b;
+            }
+        }
+    }
+}
+
+template <size_t NumLines, size_t DiffusionSteps>
+void FeedbackDelayNetwork<NumLines, DiffusionSteps>::readLines(const std::vector<SIMDFloat>& buffer,
+                                                               const Lengths& lineLengths, int index, int mask,
+                                                               float* lanes) noexcept {
+    // Every line ends at a different frame, so this gather is the only per-line access
+    const auto* values = reinterpret_cast<const float*>(buffer.data());
+    for (size_t line = 0; line < NumLines; ++line) {
+        lanes[line] = values[static_cast<size_t>((index - lineLengths[line]) & mask) * NumLines + line];
+    }
+}
+
+template <size_t NumLines, size_t DiffusionSteps>
+typename FeedbackDelayNetwork<NumLines, DiffusionSteps>::Frame
+FeedbackDelayNetwork<NumLines, DiffusionSteps>::toFrame(const std::array<float, NumLines>& values) noexcept {
+    alignas(SIMDFloat::SIMDRegisterSize) float lanes[NumLines];
+    std::copy(values.begin(), values.end(), lanes);
+
+    Frame frame;
+    for (size_t reg = 0; reg < numRegisters; ++reg) {
+        frame[reg] = SIMDFloat::fromRawArray(lanes + reg * numLanes);
+    }
+    return frame;
+}
+
+template class FeedbackDelayNetwork<8>;
+template class FeedbackDelayNetwork<16>;
+template class FeedbackDelayNetwork<16, 2>;
@@ -0,0 +1,125 @@
+#pragma once
+#include "JuceHeader.h"
+#include <array>
+#include <vector>
+
+/**
+ * @file FdnReverb.hpp
+ * @brief Feedback delay network reverb engine
+ */
+
+/**
+ * @brief Fully wet feedback delay network reverb
+ *
+ * NumLines delay lines (a power of two) with prime lengths feed back into each other through
+ * a normalized Hadamard matrix, applied as a fast Walsh-Hadamard transform. Each line has a
+ * one-pole damping filter and a feedback gain that gives all lines the same decay time.
+ * The delay lines are stored interleaved as juce::dsp::SIMDRegister frames, so one frame holds
+ * the values of all lines and the mixing, damping and feedback run on whole registers. Only the
+ * reads from the delay lines, which have a different position per line, are done per line.
+ *
+ * Optional diffusion steps spread the input over all lines before it enters the network: each
+ * step delays every line by a short prime length, mixes them with the Hadamard matrix and flips
+ * the polarity of some lines, so the tail starts dense instead of building up from echoes.
+ * @tparam NumLines Number of delay lines (8 or 16)
+ * @tparam DiffusionSteps Number of input diffusion steps (0 to 2)
+ */
+template <size_t NumLines, size_t DiffusionSteps = 0>
+class FeedbackDelayNetwork {
+public:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;                   ///< SIMD register type
+    static constexpr size_t numLanes = SIMDFloat::SIMDNumElements;      ///< Lines per register
+    static constexpr size_t numRegisters = NumLines / numLanes;         ///< Registers per frame
+
+    static_assert(NumLines >= 2 && (NumLines & (NumLines - 1)) == 0, "NumLines must be a power of two");
+    static_assert(NumLines % numLanes == 0, "A frame must fill whole SIMD registers");
+    static_assert(numLanes >= 2, "The stereo output taps need two lanes per register");
+    static_assert(DiffusionSteps <= 2, "Diffusion delays are tabulated for two steps");
+
+    /**
+     * @brief Constructor
+     */
+    FeedbackDelayNetwork() = default;
+
+    /**
+     * @brief Destructor
+     */
+    ~FeedbackDelayNetwork() = default;
+
+    /**
+     * @brief Prepare the delay lines (allocates, call from prepareToPlay only)
+     * @param sampleRate Sample rate in Hz
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Set the decay of the network
+     * @param decaySeconds Time for the tail to fall by 60 dB
+     * @param damping High-frequency damping (0.0 = none, 1.0 = maximum)
+     */
+    void setParameters(float decaySeconds, float damping);
+
+    /**
+     * @brief Replace a block of audio with the reverb output
+     * @param left Left channel, processed in place
+     * @param right Right channel, processed in place (nullptr for mono)
+     * @param numSamples Number of samples
+     */
+    void process(float* left, float* right, int numSamples) noexcept;
+
+    /**
+     * @brief Clear the delay lines and filter states
+     */
+    void reset();
+
+private:
+    using Frame = std::array<SIMDFloat, numRegisters>; ///< Values of all lines
+    using Lengths = std::array<int, NumLines>;         ///< Delay of every line in samples
+
+    /**
+     * @brief Mix all lines with the unnormalized Hadamard matrix
+     * @param lanes Values of all lines in line order (overwritten)
+     * @param frame Receives the mixed values
+     */
+    static void hadamard(float* lanes, Frame& frame) noexcept;
+
+    /**
+     * @brief Read the end of every delay line of an interleaved buffer
+     * @param buffer Interleaved frames
+     * @param lineLengths Delay of every line
+     * @param index Frame written next
+     * @param mask Frame index mask of the buffer
+     * @param lanes Receives the values of all lines in line order
+     */
+    static void readLines(const std::vector<SIMDFloat>& buffer, const Lengths& lineLengths,
+                          int index, int mask, float* lanes) noexcept;
+
+    /**
+     * @brief Build a frame from one value per line
+     * @param values Values of all lines in line order
+     * @return Frame holding the values
+     */
+    static Frame toFrame(const std::array<float, NumLines>& values) noexcept;
+
+    std::vector<SIMDFloat> delayBuffer;  ///< Interleaved delay lines, bufferLength frames of numRegisters registers
+    Lengths lengths{};                   ///< Delay of every line in samples
+    Frame feedback{};                    ///< Feedback gain of every line, including the Hadamard normalization
+    Frame lowpass{};                     ///< Damping filter state of every line
+    SIMDFloat leftInput;                 ///< Input gain on the lanes of the even lines (fed by the left channel)
+    SIMDFloat rightInput;                ///< Input gain on the lanes of the odd lines (fed by the right channel)
+    float damping = 0.0f;                ///< Damping filter coefficient
+    double sampleRate = 44100.0;         ///< Sample rate in Hz
+    int bufferMask = 0;                  ///< Frame index mask (buffer length is a power of two)
+    int writeIndex = 0;                  ///< Frame written next
+
+    std::array<std::vector<SIMDFloat>, DiffusionSteps> diffusionBuffers; ///< Interleaved delay lines of every diffusion step
+    std::array<Lengths, DiffusionSteps> diffusionLengths{};              ///< Delay of every line per diffusion step
+    std::array<Frame, DiffusionSteps> diffusionGains{};                  ///< Polarity of every line per step, including the normalization
+    std::array<int, DiffusionSteps> diffusionMasks{};                    ///< Frame index mask of every diffusion buffer
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FeedbackDelayNetwork)
+};
+
+extern template class FeedbackDelayNetwork<8>;
+extern template class FeedbackDelayNetwork<16>;
+extern template class FeedbackDelayNetwork<16, 2>;
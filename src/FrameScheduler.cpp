@@ -0,0 +1,23 @@
+#include "FrameScheduler.hpp"
+
+// FrameScheduler Implementation
+FrameScheduler::FrameScheduler(juce::Component& ownerComponent, std::function<void()> onFrame)
+    : owner(ownerComponent),
+      frameCallback(std::move(onFrame)),
+      vBlankAttachment(&ownerComponent, [this] { handleVBlank(); }) {
+}
+
+void FrameScheduler::handleVBlank() {
+    const int rateHz = !owner.isShowing() ? hiddenRateHz : (idle ? idleRateHz : frameRateHz);
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    // Displays refresh at 60 Hz or faster; allow a little jitter so a 60 Hz display gets every frame
+    if (nowMs - lastFrameMs < 1000.0 / rateHz - 2.0) {
+        return;
+    }
+
+    lastFrameMs = nowMs;
+    if (frameCallback != nullptr) {
+        frameCallback();
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "JuceHeader.h"
+#include <functional>
+
+/**
+ * @file FrameScheduler.hpp
+ * @brief Display-synchronized frame clock for the editor
+ */
+
+/**
+ * @brief Calls one frame callback per display refresh, throttled to the needed rate
+ *
+ * Driven by a juce::VBlankAttachment, so all views update in the same message-thread
+ * callback right before the display refresh instead of waking up on separate timers.
+ * Frames run at frameRateHz while something moves, at idleRateHz when the owner
+ * reports that nothing is animating, and at hiddenRateHz while the owner is not showing
+ * (minimised or detached).
+ */
+class FrameScheduler {
+public:
+    static constexpr int frameRateHz = 60;  ///< Frame rate while the UI is animating
+    static constexpr int idleRateHz = 10;   ///< Frame rate while nothing changes (polls for new activity)
+    static constexpr int hiddenRateHz = 2;  ///< Frame rate while the owner is not showing
+
+    /**
+     * @brief Constructor
+     * @param owner Component whose display refresh drives the frames (must outlive the scheduler)
+     * @param onFrame Called on the message thread for every frame
+     */
+    FrameScheduler(juce::Component& owner, std::function<void()> onFrame);
+
+    /**
+     * @brief Destructor
+     */
+    ~FrameScheduler() = default;
+
+    /**
+     * @brief Switch between the animation and the idle frame rate
+     * @param shouldBeIdle True if the last frame changed nothing and nothing is animating
+     */
+    void setIdle(bool shouldBeIdle) { idle = shouldBeIdle; }
+
+    /**
+     * @brief Check if the scheduler runs at the idle rate
+     * @return True if idle
+     */
+    bool isIdle() const { return idle; }
+
+private:
+    /**
+     * @brief Handle a display refresh and run a frame if one is due
+     */
+    void handleVBlank();
+
+    juce::Component& owner;                 ///< Component driving the frames
+    std::function<void()> frameCallback;    ///< Per-frame work
+    double lastFrameMs = 0.0;               ///< Time of the last frame in milliseconds
+    bool idle = false;                      ///< Whether the idle rate is used
+    juce::VBlankAttachment vBlankAttachment; ///< Display refresh source (declared last, detached first)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameScheduler)
+};
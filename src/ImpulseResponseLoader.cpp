@@ -0,0 +1,95 @@
+#include "ImpulseResponseLoader.hpp"
+
+// ImpulseResponseLoader Implementation
+ImpulseResponseLoader::ImpulseResponseLoader(Callback onLoaded)
+    : callback(std::move(onLoaded)) {
+    formatManager.registerBasicFormats();
+}
+
+ImpulseResponseLoader::~ImpulseResponseLoader() {
+    threadPool.removeAllJobs(true, 5000);
+}
+
+void ImpulseResponseLoader::loadFile(const juce::File& file) {
+    currentFile = file;
+    {
+        const juce::ScopedLock lock(settingsLock);
+        requestedFile = file;
+    }
+    scheduleLoad();
+}
+
+void ImpulseResponseLoader::setTrim(float headTrimSeconds, float tailLengthSeconds) {
+    const float newHeadTrim = juce::jlimit(0.0f, maxHeadTrimSeconds, headTrimSeconds);
+    const float newTailLength = juce::jlimit(0.01f, maxTailLengthSeconds, tailLengthSeconds);
+    {
+        const juce::ScopedLock lock(settingsLock);
+        if (juce::exactlyEqual(newHeadTrim, headTrim) && juce::exactlyEqual(newTailLength, tailLength)) {
+            return;
+        }
+        headTrim = newHeadTrim;
+        tailLength = newTailLength;
+    }
+
+    if (currentFile != juce::File()) {
+        scheduleLoad();
+    }
+}
+
+void ImpulseResponseLoader::scheduleLoad() {
+    // A queued load reads the latest request when it runs, so one is enough
+    if (!loadQueued.exchange(true)) {
+        threadPool.addJob([this] { runLoad(); });
+    }
+}
+
+void ImpulseResponseLoader::runLoad() {
+    loadQueued.store(false);
+
+    juce::File file;
+    float head = 0.0f;
+    float tail = 0.0f;
+    {
+        const juce::ScopedLock lock(settingsLock);
+        file = requestedFile;
+        head = headTrim;
+        tail = tailLength;
+    }
+
+    // Read the file only when it changed; trim changes reuse the cached samples
+    if (file != cachedFile) {
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr || reader->sampleRate <= 0.0) {
+            return;
+        }
+
+        const auto maxLength = static_cast<juce::int64>(reader->sampleRate * (maxHeadTrimSeconds + maxTailLengthSeconds));
+        const int length = static_cast<int>(juce::jmin(reader->lengthInSamples, maxLength));
+        const int numChannels = juce::jlimit(1, 2, static_cast<int>(reader->numChannels));
+
+        cachedSamples.setSize(numChannels, length);
+        reader->read(&cachedSamples, 0, length, 0, true, numChannels > 1);
+        cachedSampleRate = reader->sampleRate;
+        cachedFile = file;
+    }
+
+    // Cut the head and limit the tail
+    const int start = juce::jmin(cachedSamples.getNumSamples(), juce::roundToInt(head * cachedSampleRate));
+    const int length = juce::jmin(cachedSamples.getNumSamples() - start, juce::roundToInt(tail * cachedSampleRate));
+    if (length <= 0) {
+        return;
+    }
+
+    juce::AudioBuffer<float> impulseResponse(cachedSamples.getNumChannels(), length);
+    for (int channel = 0; channel < impulseResponse.getNumChannels(); ++channel) {
+        impulseResponse.copyFrom(channel, 0, cachedSamples, channel, start, length);
+    }
+
+    // A short fade keeps a shortened tail from ending in a click
+    const int fadeLength = juce::jmin(length, juce::roundToInt(fadeOutSeconds * cachedSampleRate));
+    impulseResponse.applyGainRamp(length - fadeLength, fadeLength, 1.0f, 0.0f);
+
+    if (callback != nullptr) {
+        callback(std::move(impulseResponse), cachedSampleRate);
+    }
+}
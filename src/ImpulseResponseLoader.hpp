@@ -0,0 +1,93 @@
+#pragma once
+#include "JuceHeader.h"
+#include <atomic>
+#include <functional>
+
+/**
+ * @file ImpulseResponseLoader.hpp
+ * @brief Background loading of impulse response files for the convolution reverb
+ */
+
+/**
+ * @brief Reads and trims impulse response files on a background thread
+ *
+ * The file is read once and kept in memory, so changing the head trim or the tail length
+ * only re-cuts the cached samples. Every finished impulse response is handed to the
+ * callback on the loader thread; the convolution engine then resamples and partitions it
+ * on its own background thread and swaps it in without blocking the audio thread.
+ */
+class ImpulseResponseLoader {
+public:
+    static constexpr float maxHeadTrimSeconds = 0.5f;   ///< Longest head that can be cut off
+    static constexpr float maxTailLengthSeconds = 10.0f; ///< Longest impulse response that is used
+
+    /**
+     * @brief Callback receiving a trimmed impulse response
+     * @param impulseResponse Impulse response (one or two channels)
+     * @param sampleRate Sample rate of the impulse response in Hz
+     */
+    using Callback = std::function<void(juce::AudioBuffer<float>&& impulseResponse, double sampleRate)>;
+
+    /**
+     * @brief Constructor
+     * @param onLoaded Called on the loader thread for every prepared impulse response
+     */
+    explicit ImpulseResponseLoader(Callback onLoaded);
+
+    /**
+     * @brief Destructor (waits for a running load to finish)
+     */
+    ~ImpulseResponseLoader();
+
+    /**
+     * @brief Load an impulse response file in the background (message thread only)
+     * @param file Audio file (any format the format manager can read)
+     */
+    void loadFile(const juce::File& file);
+
+    /**
+     * @brief Set the part of the impulse response that is used (message thread only)
+     *
+     * Re-cuts the loaded impulse response in the background if a value changed.
+     * @param headTrimSeconds Time cut off the start (0 to maxHeadTrimSeconds)
+     * @param tailLengthSeconds Length kept after the head (up to maxTailLengthSeconds)
+     */
+    void setTrim(float headTrimSeconds, float tailLengthSeconds);
+
+    /**
+     * @brief Get the file of the current impulse response (message thread only)
+     * @return Impulse response file, or an empty File if none was loaded
+     */
+    const juce::File& getFile() const { return currentFile; }
+
+private:
+    /**
+     * @brief Queue a background load unless one is already waiting to run
+     */
+    void scheduleLoad();
+
+    /**
+     * @brief Read the file if needed, cut the impulse response and pass it on (loader thread)
+     */
+    void runLoad();
+
+    static constexpr double fadeOutSeconds = 0.01; ///< Fade at the cut end of the tail
+
+    Callback callback;                       ///< Receives the prepared impulse responses
+    juce::AudioFormatManager formatManager;  ///< Readers for the supported file formats
+    juce::File currentFile;                  ///< File requested on the message thread
+
+    juce::CriticalSection settingsLock;      ///< Guards the request shared with the loader thread
+    juce::File requestedFile;                ///< File the next load uses
+    float headTrim = 0.0f;                   ///< Head trim the next load uses, in seconds
+    float tailLength = maxTailLengthSeconds; ///< Tail length the next load uses, in seconds
+
+    juce::File cachedFile;                   ///< File the cached samples were read from (loader thread only)
+    juce::AudioBuffer<float> cachedSamples;  ///< Samples of the cached file (loader thread only)
+    double cachedSampleRate = 0.0;           ///< Sample rate of the cached file (loader thread only)
+
+    std::atomic<bool> loadQueued{false};     ///< A load is waiting to run
+    juce::ThreadPool threadPool{1};          ///< Loader thread (declared last, stops first)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImpulseResponseLoader)
+};
@@ -0,0 +1,215 @@
+#include "LevelMeter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    /**
+     * @brief Raise an atomic to a new value if it is larger (lock-free)
+     * @param target Atomic maximum
+     * @param value Candidate value
+     */
+    void updateMaximum(std::atomic<float>& target, float value) noexcept {
+        float current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+// LevelMeter Implementation
+LevelMeter::LevelMeter() {
+    // Windowed-sinc interpolation filter, split into one sub-filter per output phase
+    constexpr int numTaps = tapsPerPhase * oversampling;
+    constexpr double centre = (numTaps - 1) * 0.5;
+    constexpr double cutoff = 0.9; // Fraction of the original Nyquist frequency
+
+    for (int phase = 0; phase < oversampling; ++phase) {
+        double phaseGain = 0.0;
+
+        for (int k = 0; k < tapsPerPhase; ++k) {
+            const int tap = k * oversampling + phase;
+            const double t = (tap - centre) / oversampling;
+            const double sinc = std::abs(t) < 1e-9 ? 1.0
+                                                   : std::sin(juce::MathConstants<double>::pi * cutoff * t)
+                                                         / (juce::MathConstants<double>::pi * cutoff * t);
+            const double x = juce::MathConstants<double>::twoPi * (tap + 0.5) / numTaps;
+            const double window = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x); // Blackman
+
+            interpolator[static_cast<size_t>(k)][static_cast<size_t>(phase)] = static_cast<float>(sinc * window);
+            phaseGain += sinc * window;
+        }
+
+        // Unity gain at DC for every phase
+        for (auto& taps : interpolator) {
+            taps[static_cast<size_t>(phase)] = static_cast<float>(taps[static_cast<size_t>(phase)] / phaseGain);
+        }
+    }
+}
+
+void LevelMeter::prepare(double newSampleRate, int maximumBlockSize) {
+    sampleRate = newSampleRate;
+    chunkSize = juce::jmax(1, maximumBlockSize);
+    samplesPerBin = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    // K-weighting filters (ITU-R BS.1770), recalculated for the actual sample rate
+    const double shelfK = std::tan(juce::MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+    const double shelfQ = 0.7071752369554196;
+    const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    const double shelfA0 = 1.0 + shelfK / shelfQ + shelfK * shelfK;
+
+    const double highPassK = std::tan(juce::MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+    const double highPassQ = 0.5003270373238773;
+    const double highPassA0 = 1.0 + highPassK / highPassQ + highPassK * highPassK;
+
+    for (auto& channel : channels) {
+        channel.shelf.b0 = static_cast<float>((vh + vb * shelfK / shelfQ + shelfK * shelfK) / shelfA0);
+        channel.shelf.b1 = static_cast<float>(2.0 * (shelfK * shelfK - vh) / shelfA0);
+        channel.shelf.b2 = static_cast<float>((vh - vb * shelfK / shelfQ + shelfK * shelfK) / shelfA0);
+        channel.shelf.a1 = static_cast<float>(2.0 * (shelfK * shelfK - 1.0) / shelfA0);
+        channel.shelf.a2 = static_cast<float>((1.0 - shelfK / shelfQ + shelfK * shelfK) / shelfA0);
+
+        channel.highPass.b0 = 1.0f;
+        channel.highPass.b1 = -2.0f;
+        channel.highPass.b2 = 1.0f;
+        channel.highPass.a1 = static_cast<float>(2.0 * (highPassK * highPassK - 1.0) / highPassA0);
+        channel.highPass.a2 = static_cast<float>((1.0 - highPassK / highPassQ + highPassK * highPassK) / highPassA0);
+
+        channel.history.assign(static_cast<size_t>(tapsPerPhase - 1 + chunkSize), 0.0f);
+    }
+
+    reset();
+}
+
+void LevelMeter::process(const juce::AudioBuffer<float>& buffer, int numSamples) {
+    const int numChannels = juce::jmin(maxChannels, buffer.getNumChannels());
+    if (numChannels == 0 || chunkSize == 0) {
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        processChunk(buffer, start, juce::jmin(chunkSize, numSamples - start), numChannels);
+    }
+
+    // A mono output is shown on both sides
+    for (int channel = numChannels; channel < maxChannels; ++channel) {
+        const auto& source = channels[0];
+        auto& target = channels[static_cast<size_t>(channel)];
+        target.rms.store(source.rms.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        updateMaximum(target.peak, source.peak.load(std::memory_order_relaxed));
+        updateMaximum(target.truePeak, source.truePeak.load(std::memory_order_relaxed));
+    }
+}
+
+LevelMeter::ChannelLevels LevelMeter::getChannelLevels(int channel) {
+    jassert(channel >= 0 && channel < maxChannels);
+    auto& state = channels[static_cast<size_t>(channel)];
+
+    ChannelLevels levels;
+    levels.rms = state.rms.load(std::memory_order_relaxed);
+    levels.peak = state.peak.exchange(0.0f, std::memory_order_relaxed);
+    levels.truePeak = state.truePeak.exchange(0.0f, std::memory_order_relaxed);
+    return levels;
+}
+
+void LevelMeter::reset() {
+    for (auto& channel : channels) {
+        channel.shelf.s1 = channel.shelf.s2 = 0.0f;
+        channel.highPass.s1 = channel.highPass.s2 = 0.0f;
+        std::fill(channel.history.begin(), channel.history.end(), 0.0f);
+        channel.meanSquare = 0.0f;
+        channel.peak.store(0.0f);
+        channel.rms.store(0.0f);
+        channel.truePeak.store(0.0f);
+    }
+
+    binEnergy.fill(0.0);
+    binSamples.fill(0);
+    currentBinEnergy = 0.0;
+    currentBinSamples = 0;
+    nextBin = 0;
+    shortTermLoudness.store(minLoudness);
+}
+
+void LevelMeter::processChunk(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                              int numChannels) {
+    constexpr int historyLength = tapsPerPhase - 1;
+    const float rmsCoefficient = 1.0f - static_cast<float>(std::exp(-numSamples / (0.3 * sampleRate)));
+    double loudnessEnergy = 0.0;
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        auto& state = channels[static_cast<size_t>(channel)];
+        float* history = state.history.data();
+        std::memcpy(history + historyLength, buffer.getReadPointer(channel, startSample),
+                    static_cast<size_t>(numSamples) * sizeof(float));
+
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        float weightedSumSquares = 0.0f;
+        std::array<float, oversampling> phasePeak{};
+
+        // One pass over the samples for all measurements
+        for (int i = 0; i < numSamples; ++i) {
+            const float* newest = history + historyLength + i;
+            const float x = *newest;
+
+            peak = juce::jmax(peak, std::abs(x));
+            sumSquares += x * x;
+
+            const float weighted = state.highPass.process(state.shelf.process(x));
+            weightedSumSquares += weighted * weighted;
+
+            // All output phases at once; the fixed-width inner loops map to one SIMD register
+            std::array<float, oversampling> interpolated{};
+            for (size_t k = 0; k < tapsPerPhase; ++k) {
+                const float sample = newest[-static_cast<int>(k)];
+                for (size_t phase = 0; phase < oversampling; ++phase) {
+                    interpolated[phase] += interpolator[k][phase] * sample;
+                }
+            }
+            for (size_t phase = 0; phase < oversampling; ++phase) {
+                phasePeak[phase] = juce::jmax(phasePeak[phase], std::abs(interpolated[phase]));
+            }
+        }
+
+        // Keep the newest samples for the interpolator of the next chunk
+        std::memmove(history, history + numSamples, static_cast<size_t>(historyLength) * sizeof(float));
+
+        state.meanSquare += (sumSquares / static_cast<float>(numSamples) - state.meanSquare) * rmsCoefficient;
+        state.rms.store(std::sqrt(state.meanSquare), std::memory_order_relaxed);
+
+        const float truePeak = juce::jmax(peak, *std::max_element(phasePeak.begin(), phasePeak.end()));
+        updateMaximum(state.peak, peak);
+        updateMaximum(state.truePeak, truePeak);
+
+        loudnessEnergy += weightedSumSquares;
+    }
+
+    addLoudnessEnergy(loudnessEnergy, numSamples);
+}
+
+void LevelMeter::addLoudnessEnergy(double energy, int numSamples) {
+    currentBinEnergy += energy;
+    currentBinSamples += numSamples;
+
+    if (currentBinSamples >= samplesPerBin) {
+        binEnergy[static_cast<size_t>(nextBin)] = currentBinEnergy;
+        binSamples[static_cast<size_t>(nextBin)] = currentBinSamples;
+        nextBin = (nextBin + 1) % loudnessBins;
+        currentBinEnergy = 0.0;
+        currentBinSamples = 0;
+
+        // Short-term loudness over the completed bins (3 s)
+        double windowEnergy = 0.0;
+        int windowSamples = 0;
+        for (int bin = 0; bin < loudnessBins; ++bin) {
+            windowEnergy += binEnergy[static_cast<size_t>(bin)];
+            windowSamples += binSamples[static_cast<size_t>(bin)];
+        }
+
+        const double meanSquare = windowEnergy / juce::jmax(1, windowSamples);
+        const double loudness = meanSquare > 0.0 ? -0.691 + 10.0 * std::log10(meanSquare) : minLoudness;
+        shortTermLoudness.store(static_cast<float>(juce::jmax(static_cast<double>(minLoudness), loudness)),
+                                std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "JuceHeader.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * @file LevelMeter.hpp
+ * @brief Single-pass output metering (peak, RMS, true-peak and short-term loudness)
+ */
+
+/**
+ * @brief Output level meter running on the audio thread
+ *
+ * Every sample is read once per channel. The same loop tracks the sample peak, the
+ * energy for the RMS level, the 4x-oversampled true-peak (ITU-R BS.1770 style polyphase
+ * interpolator) and the K-weighted energy for short-term loudness (3 s window, in LUFS).
+ * The results are published with relaxed atomic stores, so the UI can read them at any time.
+ */
+class LevelMeter {
+public:
+    static constexpr int maxChannels = 2;          ///< Metered channels (extra channels are ignored)
+    static constexpr int oversampling = 4;         ///< True-peak oversampling factor
+    static constexpr int tapsPerPhase = 12;        ///< Interpolation filter taps per output phase
+    static constexpr float minLoudness = -70.0f;   ///< Reported loudness of silence in LUFS
+
+    /**
+     * @brief Levels of one channel
+     */
+    struct ChannelLevels {
+        float peak = 0.0f;      ///< Sample peak since the previous read (linear)
+        float rms = 0.0f;       ///< RMS level with 300 ms integration (linear)
+        float truePeak = 0.0f;  ///< 4x-oversampled peak since the previous read (linear)
+    };
+
+    /**
+     * @brief Constructor
+     */
+    LevelMeter();
+
+    /**
+     * @brief Destructor
+     */
+    ~LevelMeter() = default;
+
+    /**
+     * @brief Prepare the meter (allocates, call from prepareToPlay only)
+     * @param sampleRate Sample rate in Hz
+     * @param maximumBlockSize Largest expected block size (larger blocks are metered in chunks)
+     */
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    /**
+     * @brief Meter a block of audio
+     * @param buffer Audio to meter
+     * @param numSamples Number of samples to meter
+     */
+    void process(const juce::AudioBuffer<float>& buffer, int numSamples);
+
+    /**
+     * @brief Get the latest levels of a channel and restart its peak measurement (thread-safe)
+     *
+     * Peaks are held until they are read, so a slow UI never misses one. Call from a single
+     * reader thread only.
+     * @param channel Channel index (0 to maxChannels - 1)
+     * @return Channel levels
+     */
+    ChannelLevels getChannelLevels(int channel);
+
+    /**
+     * @brief Get the short-term loudness of all channels (thread-safe)
+     * @return Loudness in LUFS (minLoudness for silence)
+     */
+    float getShortTermLoudness() const { return shortTermLoudness.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Clear all filter states and levels
+     */
+    void reset();
+
+private:
+    /**
+     * @brief Biquad in transposed direct form II
+     */
+    struct Biquad {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f; ///< Coefficients (a0 = 1)
+        float s1 = 0.0f, s2 = 0.0f;                                  ///< State
+
+        /**
+         * @brief Filter one sample
+         * @param x Input sample
+         * @return Output sample
+         */
+        forcedinline float process(float x) noexcept {
+            const float y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    /**
+     * @brief Filter and level state of one channel
+     */
+    struct ChannelState {
+        Biquad shelf;                          ///< K-weighting stage 1 (head high shelf)
+        Biquad highPass;                       ///< K-weighting stage 2 (RLB high-pass)
+        std::vector<float> history;            ///< Last tapsPerPhase - 1 samples followed by the current chunk
+        float meanSquare = 0.0f;               ///< Integrated mean square for the RMS level
+        std::atomic<float> peak{0.0f};         ///< Published sample peak
+        std::atomic<float> rms{0.0f};          ///< Published RMS level
+        std::atomic<float> truePeak{0.0f};     ///< Published true-peak
+    };
+
+    /**
+     * @brief Meter a chunk of at most maximumBlockSize samples
+     * @param buffer Audio to meter
+     * @param startSample First sample of the chunk
+     * @param numSamples Number of samples in the chunk
+     * @param numChannels Number of channels to meter
+     */
+    void processChunk(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples, int numChannels);
+
+    /**
+     * @brief Add K-weighted energy to the loudness window
+     * @param energy Sum of squared K-weighted samples over all channels
+     * @param numSamples Number of samples the energy was summed over
+     */
+    void addLoudnessEnergy(double energy, int numSamples);
+
+    static constexpr int loudnessBins = 30;   ///< 100 ms bins in the 3 s short-term window
+
+    /// Interpolation filter, coefficient k of all output phases next to each other
+    std::array<std::array<float, oversampling>, tapsPerPhase> interpolator{};
+
+    std::array<ChannelState, maxChannels> channels; ///< Per-channel state
+    std::array<double, loudnessBins> binEnergy{};  ///< K-weighted energy of the completed bins
+    std::array<int, loudnessBins> binSamples{};    ///< Length of the completed bins in samples
+    double currentBinEnergy = 0.0;                  ///< Energy of the bin being filled
+    int currentBinSamples = 0;                      ///< Samples in the bin being filled
+    int samplesPerBin = 4410;                       ///< Bin length in samples
+    int nextBin = 0;                                ///< Bin to overwrite next
+    int chunkSize = 0;                              ///< Largest chunk processed at once
+    double sampleRate = 44100.0;                    ///< Sample rate in Hz
+    std::atomic<float> shortTermLoudness{minLoudness}; ///< Published short-term loudness
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include "JuceHeader.h"
+#include <array>
 #include <cmath>
+#include <type_traits>
 
 /**
  * @file Oscillator.hpp
@@ -59,6 +61,17 @@ public:
      */
     virtual float getNextSample() = 0;
 
+    /**
+     * @brief Render a block of samples
+     * @param output Output buffer to write to
+     * @param numSamples Number of samples to render
+     */
+    virtual void renderBlock(float* output, int numSamples) {
+        for (int sample = 0; sample < numSamples; ++sample) {
+            output[sample] = getNextSample();
+        }
+    }
+
     /**
      * @brief Reset the oscillator phase
      */
@@ -143,12 +156,28 @@ protected:
     double toadNasalDelta = 0.0;    ///< Phase increment for nasal component
     float toadNasalFreq = 1080.0f;  ///< Nasal formant frequency
     float toadVibratoFreq = 4.5f;   ///< Vibrato frequency
+
+    /**
+     * @brief Render a block with a statically bound oscillator
+     *
+     * Derived classes are final, so the qualified getNextSample() call below is resolved
+     * at compile time and can be inlined into the loop instead of a virtual call per sample.
+     * @param oscillator Oscillator to render
+     * @param output Output buffer to write to
+     * @param numSamples Number of samples to render
+     */
+    template <typename OscillatorType>
+    static void renderBlockWith(OscillatorType& oscillator, float* output, int numSamples) {
+        for (int sample = 0; sample < numSamples; ++sample) {
+            output[sample] = oscillator.OscillatorType::getNextSample();
+        }
+    }
 };
 
 /**
  * @brief Toad-voice enhanced sine wave oscillator
  */
-class SineOscillator : public BaseOscillator {
+class SineOscillator final : public BaseOscillator {
 public:
     /**
      * @brief Get the next Toad-like sine wave sample
@@ -165,12 +194,19 @@ public:
         float sample = baseSample + harmonic2 + harmonic3;
         return applyToadCharacteristics(sample);
     }
+
+    /**
+     * @brief Render a block of samples without per-sample virtual dispatch
+     * @param output Output buffer to write to
+     * @param numSamples Number of samples to render
+     */
+    void renderBlock(float* output, int numSamples) override { renderBlockWith(*this, output, numSamples); }
 };
 
 /**
  * @brief Toad-voice enhanced square wave oscillator
  */
-class SquareOscillator : public BaseOscillator {
+class SquareOscillator final : public BaseOscillator {
 public:
     /**
      * @brief Get the next Toad-like square wave sample
@@ -190,12 +226,19 @@ public:
 
         return applyToadCharacteristics(sample);
     }
+
+    /**
+     * @brief Render a block of samples without per-sample virtual dispatch
+     * @param output Output buffer to write to
+     * @param numSamples Number of samples to render
+     */
+    void renderBlock(float* output, int numSamples) override { renderBlockWith(*this, output, numSamples); }
 };
 
 /**
  * @brief Toad-voice enhanced sawtooth wave oscillator
  */
-class SawOscillator : public BaseOscillator {
+class SawOscillator final : public BaseOscillator {
 public:
     /**
      * @brief Get the next Toad-like sawtooth wave sample
@@ -214,12 +257,19 @@ public:
         float sample = baseSaw + harmonic4 + harmonic6;
         return applyToadCharacteristics(sample);
     }
+
+    /**
+     * @brief Render a block of samples without per-sample virtual dispatch
+     * @param output Output buffer to write to
+     * @param numSamples Number of samples to render
+     */
+    void renderBlock(float* output, int numSamples) override { renderBlockWith(*this, output, numSamples); }
 };
 
 /**
  * @brief Toad-voice enhanced triangle wave oscillator
  */
-class TriangleOscillator : public BaseOscillator {
+class TriangleOscillator final : public BaseOscillator {
 public:
     /**
      * @brief Get the next Toad-like triangle wave sample
@@ -238,6 +288,13 @@ public:
         float sample = baseTriangle + formant1 + formant2;
         return applyToadCharacteristics(sample);
     }
+
+    /**
+     * @brief Render a block of samples without per-sample virtual dispatch
+     * @param output Output buffer to write to
+     * @param numSamples Number of samples to render
+     */
+    void renderBlock(float* output, int numSamples) override { renderBlockWith(*this, output, numSamples); }
 };
 
 /**
@@ -245,65 +302,166 @@ public:
  */
 class OscillatorUtils {
 public:
+    using OscSampleFunction = float (*)(double, float, double); ///< Type-resolved getOscSample()
+    using CycleRenderer = void (*)(float*, int);                ///< Type-resolved renderCycle()
+
     /**
-     * @brief Generate a single Toad-enhanced oscillator sample based on type and angle
-     * @param type Oscillator type
+     * @brief Generate a single Toad-enhanced oscillator sample for a fixed oscillator type
+     *
+     * The waveform is selected at compile time, so loops over this function contain no
+     * branch on the oscillator type and can be vectorized.
+     * @tparam Type Oscillator type
      * @param angle Current phase angle
      * @param frequency Current frequency for Toad characteristics
      * @param sampleRate Sample rate for proper scaling
      * @return Generated sample with Toad voice characteristics
      */
-    static float getOscSample(OscType type, double angle, float frequency = 440.0f, double sampleRate = 44100.0) {
+    template <OscType Type>
+    static float getOscSample(double angle, float frequency = 440.0f, double sampleRate = 44100.0) {
         float baseSample = 0.0f;
 
-        switch (type) {
-        case OscType::Sine:
+        if constexpr (Type == OscType::Sine) {
             baseSample = static_cast<float>(std::sin(angle));
             // Add harmonics for vocal quality
             baseSample += std::sin(angle * 2.0) * 0.1f + std::sin(angle * 3.0) * 0.05f;
-            break;
-        case OscType::Square:
+        } else if constexpr (Type == OscType::Square) {
             baseSample = (std::sin(angle) >= 0.0 ? 1.0f : -1.0f);
             // Soften and add roughness
             baseSample *= (0.95f + std::sin(angle * 5.0) * 0.08f);
             baseSample += std::sin(angle * 7.3) * 0.12f;
-            break;
-        case OscType::Saw:
-            baseSample = static_cast<float>(
-                2.0 * (angle / juce::MathConstants<double>::twoPi -
-                       std::floor(0.5 + angle / juce::MathConstants<double>::twoPi)));
+        } else if constexpr (Type == OscType::Saw) {
+            baseSample = static_cast<float>(getSawSample(angle));
             // Add harmonic emphasis
             baseSample += std::sin(angle * 4.0) * 0.08f + std::sin(angle * 6.0) * 0.04f;
-            break;
-        case OscType::Triangle:
-            baseSample = 2.0f * static_cast<float>(
-                std::abs(2.0 * (angle / juce::MathConstants<double>::twoPi -
-                               std::floor(0.5 + angle / juce::MathConstants<double>::twoPi)))) - 1.0f;
+        } else if constexpr (Type == OscType::Triangle) {
+            baseSample = 2.0f * static_cast<float>(std::abs(getSawSample(angle))) - 1.0f;
             // Add formant-like resonances
             baseSample += std::sin(angle * 2.3) * 0.06f + std::sin(angle * 3.7) * 0.04f;
-            break;
-        default:
+        } else {
             return 0.0f;
         }
 
         // Apply simplified Toad characteristics
         float nasalFreq = frequency * 2.7f;
         double nasalAngle = (nasalFreq / sampleRate) * angle;
-        float nasalComponent = std::sin(nasalAngle) * 0.15f;
+        float nasal = static_cast<float>(std::sin(nasalAngle));
+        float vibrato = static_cast<float>(std::sin(angle * 0.01f * frequency / 440.0f));
 
-        float vibratoMod = 1.0f + std::sin(angle * 0.01f * frequency / 440.0f) * 0.08f;
+        return applyToadCharacteristics(baseSample, nasal, vibrato);
+    }
 
-        float toadSample = baseSample * vibratoMod + nasalComponent * baseSample;
+    /**
+     * @brief Generate a single Toad-enhanced oscillator sample based on type and angle
+     *
+     * Convenience wrapper for occasional calls; per-sample loops should resolve the type
+     * once with getOscSampleFunction() instead.
+     * @param type Oscillator type
+     * @param angle Current phase angle
+     * @param frequency Current frequency for Toad characteristics
+     * @param sampleRate Sample rate for proper scaling
+     * @return Generated sample with Toad voice characteristics
+     */
+    static float getOscSample(OscType type, double angle, float frequency = 440.0f, double sampleRate = 44100.0) {
+        return getOscSampleFunction(type)(angle, frequency, sampleRate);
+    }
 
-        // Subtle harmonic distortion
-        float distortion = toadSample * 0.3f;
-        if (distortion > 0.1f) {
-            distortion = 0.1f + (distortion - 0.1f) * 0.7f;
-        } else if (distortion < -0.1f) {
-            distortion = -0.1f + (distortion + 0.1f) * 0.7f;
+    /**
+     * @brief Resolve the getOscSample() instantiation for an oscillator type
+     * @param type Oscillator type
+     * @return Function generating samples of that type (silence for invalid types)
+     */
+    static OscSampleFunction getOscSampleFunction(OscType type) {
+        static constexpr std::array<OscSampleFunction, static_cast<size_t>(OscType::NumTypes)> functions{
+            &getOscSample<OscType::Sine>, &getOscSample<OscType::Square>,
+            &getOscSample<OscType::Saw>, &getOscSample<OscType::Triangle>
+        };
+
+        const auto index = static_cast<size_t>(type);
+        return index < functions.size() ? functions[index] : &getOscSample<OscType::NumTypes>;
+    }
+
+    /**
+     * @brief Generate one sample of the periodic (single-cycle) Toad waveform
+     *
+     * This is the waveform of getOscSample() without the phase-driven modulation, with every
+     * harmonic overlay rounded to an integer multiple of the fundamental so that one cycle
+     * can be stored in a wavetable (7.3 -> 7, 2.3 -> 2, 3.7 -> 4).
+     * @tparam Type Oscillator type
+     * @param angle Phase angle within the cycle (0 to 2*pi)
+     * @return Generated sample
+     */
+    template <OscType Type>
+    static float getPeriodicSample(double angle) {
+        if constexpr (Type == OscType::Sine) {
+            return static_cast<float>(std::sin(angle) + std::sin(angle * 2.0) * 0.1 + std::sin(angle * 3.0) * 0.05);
+        } else if constexpr (Type == OscType::Square) {
+            return static_cast<float>((std::sin(angle) >= 0.0 ? 1.0 : -1.0) * (0.95 + std::sin(angle * 5.0) * 0.08) +
+                                      std::sin(angle * 7.0) * 0.12);
+        } else if constexpr (Type == OscType::Saw) {
+            return static_cast<float>(getSawSample(angle) + std::sin(angle * 4.0) * 0.08 + std::sin(angle * 6.0) * 0.04);
+        } else if constexpr (Type == OscType::Triangle) {
+            return static_cast<float>(2.0 * std::abs(getSawSample(angle)) - 1.0 + std::sin(angle * 2.0) * 0.06 +
+                                      std::sin(angle * 4.0) * 0.04);
+        } else {
+            return 0.0f;
         }
+    }
 
-        return baseSample * 0.7f + (toadSample + distortion) * 0.3f;
+    /**
+     * @brief Render one cycle of the periodic Toad waveform for a fixed oscillator type
+     * @tparam Type Oscillator type
+     * @param output Output buffer to write to
+     * @param numSamples Number of samples per cycle
+     */
+    template <OscType Type>
+    static void renderCycle(float* output, int numSamples) {
+        const double angleDelta = juce::MathConstants<double>::twoPi / numSamples;
+        for (int sample = 0; sample < numSamples; ++sample) {
+            output[sample] = getPeriodicSample<Type>(angleDelta * sample);
+        }
+    }
+
+    /**
+     * @brief Resolve the renderCycle() instantiation for an oscillator type
+     * @param type Oscillator type
+     * @return Function rendering one cycle of that type (silence for invalid types)
+     */
+    static CycleRenderer getCycleRenderer(OscType type) {
+        static constexpr std::array<CycleRenderer, static_cast<size_t>(OscType::NumTypes)> renderers{
+            &renderCycle<OscType::Sine>, &renderCycle<OscType::Square>,
+            &renderCycle<OscType::Saw>, &renderCycle<OscType::Triangle>
+        };
+
+        const auto index = static_cast<size_t>(type);
+        return index < renderers.size() ? renderers[index] : &renderCycle<OscType::NumTypes>;
+    }
+
+    /**
+     * @brief Apply nasal resonance, vibrato and soft distortion to a sample
+     *
+     * Written without branches so it can process a single float or a whole
+     * juce::dsp::SIMDRegister<float> of voices with the same code.
+     * @tparam SampleType float or juce::dsp::SIMDRegister<float>
+     * @param baseSample Raw oscillator sample
+     * @param nasal Nasal LFO value (-1.0 to 1.0)
+     * @param vibrato Vibrato LFO value (-1.0 to 1.0)
+     * @return Sample with Toad voice characteristics
+     */
+    template <typename SampleType>
+    static forcedinline SampleType applyToadCharacteristics(SampleType baseSample, SampleType nasal,
+                                                            SampleType vibrato) noexcept {
+        const SampleType toadSample = baseSample * (vibrato * 0.08f + 1.0f) + nasal * 0.15f * baseSample;
+
+        // Subtle harmonic distortion: slope 0.7 outside +-0.1
+        const SampleType distortion = toadSample * 0.3f;
+        SampleType clipped;
+        if constexpr (std::is_floating_point_v<SampleType>) {
+            clipped = juce::jlimit(-0.1f, 0.1f, distortion);
+        } else {
+            clipped = SampleType::min(SampleType::max(distortion, SampleType::expand(-0.1f)), SampleType::expand(0.1f));
+        }
+
+        return baseSample * 0.7f + (toadSample + clipped + (distortion - clipped) * 0.7f) * 0.3f;
     }
 
     /**
@@ -317,4 +475,15 @@ public:
         auto cyclesPerSample = frequency / sampleRate;
         return cyclesPerSample * juce::MathConstants<double>::twoPi;
     }
-};
\ No newline at end of file
+
+private:
+    /**
+     * @brief Naive sawtooth shared by the saw and triangle waveforms
+     * @param angle Phase angle
+     * @return Sawtooth value (-1.0 to 1.0)
+     */
+    static double getSawSample(double angle) {
+        return 2.0 * (angle / juce::MathConstants<double>::twoPi -
+                      std::floor(0.5 + angle / juce::MathConstants<double>::twoPi));
+    }
+};
@@ -0,0 +1,117 @@
+#include "OscillatorBank.hpp"
+
+// OscillatorBank Implementation
+void OscillatorBank::prepare(const WavetableBank& wavetableBank, double newSampleRate) {
+    bank = &wavetableBank;
+    sampleRate = newSampleRate;
+
+    frequencies.fill(440.0f);
+    phaseDelta.fill(0u);
+    nasalDelta.fill(0u);
+    vibratoDelta.fill(0u);
+    for (int voice = 0; voice < maxVoices; ++voice) {
+        updateTable(voice);
+    }
+
+    reset();
+}
+
+void OscillatorBank::startVoice(int voice, float frequency, bool resetPhase) {
+    jassert(voice >= 0 && voice < maxVoices);
+    const auto index = static_cast<size_t>(voice);
+
+    if (resetPhase) {
+        phase[index] = 0u;
+        nasalPhase[index] = 0u;
+        vibratoPhase[index] = 0u;
+    }
+
+    frequencies[index] = frequency;
+    phaseDelta[index] = sampleRate > 0.0 ? PhaseAccumulator::toIncrement(frequency / sampleRate) : 0u;
+    nasalDelta[index] = static_cast<juce::uint32>(phaseDelta[index] * nasalRatio);
+    vibratoDelta[index] = static_cast<juce::uint32>(phaseDelta[index] * vibratoRatio);
+    updateTable(voice);
+}
+
+void OscillatorBank::setOscType(OscType type) {
+    if (type == oscType) {
+        return;
+    }
+
+    oscType = type;
+    for (int voice = 0; voice < maxVoices; ++voice) {
+        updateTable(voice);
+    }
+}
+
+void OscillatorBank::renderBlock(float* const* outputs, juce::uint32 activeVoiceMask, int numSamples) noexcept {
+    constexpr juce::uint32 laneMask = (1u << numLanes) - 1u;
+
+    for (int group = 0; group < maxVoices; group += numLanes) {
+        // Skip register groups without any sounding voice
+        if (((activeVoiceMask >> group) & laneMask) == 0) {
+            continue;
+        }
+
+        const auto first = static_cast<size_t>(group);
+        auto groupPhase = SIMDPhase::fromRawArray(phase.data() + first);
+        auto groupNasalPhase = SIMDPhase::fromRawArray(nasalPhase.data() + first);
+        auto groupVibratoPhase = SIMDPhase::fromRawArray(vibratoPhase.data() + first);
+        const auto groupDelta = SIMDPhase::fromRawArray(phaseDelta.data() + first);
+        const auto groupNasalDelta = SIMDPhase::fromRawArray(nasalDelta.data() + first);
+        const auto groupVibratoDelta = SIMDPhase::fromRawArray(vibratoDelta.data() + first);
+
+        alignas(SIMDPhase::SIMDRegisterSize) juce::uint32 lanePhase[numLanes];
+        alignas(SIMDPhase::SIMDRegisterSize) juce::uint32 laneNasalPhase[numLanes];
+        alignas(SIMDPhase::SIMDRegisterSize) juce::uint32 laneVibratoPhase[numLanes];
+        alignas(SIMDFloat::SIMDRegisterSize) float laneBase[numLanes];
+        alignas(SIMDFloat::SIMDRegisterSize) float laneNasal[numLanes];
+        alignas(SIMDFloat::SIMDRegisterSize) float laneVibrato[numLanes];
+        alignas(SIMDFloat::SIMDRegisterSize) float laneOutput[numLanes];
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+            groupPhase.copyToRawArray(lanePhase);
+            groupNasalPhase.copyToRawArray(laneNasalPhase);
+            groupVibratoPhase.copyToRawArray(laneVibratoPhase);
+
+            // Table reads and phase conversions are the only per-voice work
+            for (int lane = 0; lane < numLanes; ++lane) {
+                laneBase[lane] = WavetableBank::lookup(tables[first + static_cast<size_t>(lane)], lanePhase[lane]);
+                laneNasal[lane] = PhaseAccumulator::toNormalized(laneNasalPhase[lane]);
+                laneVibrato[lane] = PhaseAccumulator::toNormalized(laneVibratoPhase[lane]);
+            }
+
+            // Fixed-point phases wrap on overflow, no compare needed
+            groupPhase += groupDelta;
+            groupNasalPhase += groupNasalDelta;
+            groupVibratoPhase += groupVibratoDelta;
+
+            OscillatorUtils::applyToadCharacteristics(SIMDFloat::fromRawArray(laneBase),
+                                                      FastMath::sinCycle(SIMDFloat::fromRawArray(laneNasal)),
+                                                      FastMath::sinCycle(SIMDFloat::fromRawArray(laneVibrato)))
+                .copyToRawArray(laneOutput);
+
+            for (int lane = 0; lane < numLanes; ++lane) {
+                if ((activeVoiceMask >> (group + lane)) & 1u) {
+                    outputs[group + lane][sample] = laneOutput[lane];
+                }
+            }
+        }
+
+        groupPhase.copyToRawArray(phase.data() + first);
+        groupNasalPhase.copyToRawArray(nasalPhase.data() + first);
+        groupVibratoPhase.copyToRawArray(vibratoPhase.data() + first);
+    }
+}
+
+void OscillatorBank::reset() {
+    phase.fill(0u);
+    nasalPhase.fill(0u);
+    vibratoPhase.fill(0u);
+}
+
+void OscillatorBank::updateTable(int voice) {
+    if (bank != nullptr) {
+        tables[static_cast<size_t>(voice)] = bank->getTable(oscType, frequencies[static_cast<size_t>(voice)]);
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "JuceHeader.h"
+#include "Oscillator.hpp"
+#include "Wavetable.hpp"
+#include "Utils.hpp"
+#include "FastMath.hpp"
+#include <array>
+
+/**
+ * @file OscillatorBank.hpp
+ * @brief Structure-of-arrays oscillator kernel rendering several voices per SIMD instruction
+ */
+
+/**
+ * @brief Wavetable oscillators of all voices, stored as a structure of arrays
+ *
+ * The phase state of every voice lives in aligned arrays (one entry per voice), so
+ * the phase accumulators and the Toad characteristics of juce::dsp::SIMDRegister<float>::size()
+ * voices are computed with one instruction each. Only the wavetable reads and the fixed-point
+ * to float phase conversions of the LFOs are done per voice.
+ * Phases are 32-bit fixed point (see PhaseAccumulator) and wrap on integer overflow.
+ */
+class OscillatorBank {
+public:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;                        ///< SIMD sample register
+    using SIMDPhase = juce::dsp::SIMDRegister<juce::uint32>;                 ///< SIMD fixed-point phase register
+    static constexpr int numLanes = static_cast<int>(SIMDFloat::SIMDNumElements); ///< Voices per register
+    static constexpr int maxVoices = 32;                                     ///< Number of oscillator slots
+
+    static_assert(maxVoices % numLanes == 0, "maxVoices must be a multiple of the SIMD width");
+    static_assert(SIMDPhase::SIMDNumElements == SIMDFloat::SIMDNumElements, "Phase and sample lanes must match");
+    static_assert(maxVoices <= 32, "Active voices are passed as a 32-bit mask");
+
+    /**
+     * @brief Constructor
+     */
+    OscillatorBank() = default;
+
+    /**
+     * @brief Destructor
+     */
+    ~OscillatorBank() = default;
+
+    /**
+     * @brief Prepare all oscillators
+     * @param wavetableBank Bank to read the tables from (must be prepared and outlive the oscillators)
+     * @param sampleRate Sample rate in Hz
+     */
+    void prepare(const WavetableBank& wavetableBank, double sampleRate);
+
+    /**
+     * @brief Start an oscillator at a new frequency
+     * @param voice Oscillator slot (0 to maxVoices - 1)
+     * @param frequency Frequency in Hz
+     * @param resetPhase True to restart the phases (false keeps retriggered voices click-free)
+     */
+    void startVoice(int voice, float frequency, bool resetPhase);
+
+    /**
+     * @brief Set the oscillator type of all voices (call once per block, not per sample)
+     * @param type Oscillator type
+     */
+    void setOscType(OscType type);
+
+    /**
+     * @brief Render the oscillators of the active voices
+     * @param outputs One output buffer per voice slot; only rows of active voices are written
+     * @param activeVoiceMask Bit n set if voice n has to be rendered
+     * @param numSamples Number of samples to render
+     */
+    void renderBlock(float* const* outputs, juce::uint32 activeVoiceMask, int numSamples) noexcept;
+
+    /**
+     * @brief Get the oscillator phase of a voice
+     * @param voice Oscillator slot (0 to maxVoices - 1)
+     * @return Fixed-point phase of the next sample to render
+     */
+    juce::uint32 getPhase(int voice) const noexcept { return phase[static_cast<size_t>(voice)]; }
+
+    /**
+     * @brief Get the oscillator phase increment of a voice
+     * @param voice Oscillator slot (0 to maxVoices - 1)
+     * @return Fixed-point phase increment per sample
+     */
+    juce::uint32 getPhaseIncrement(int voice) const noexcept { return phaseDelta[static_cast<size_t>(voice)]; }
+
+    /**
+     * @brief Reset all phases to zero
+     */
+    void reset();
+
+private:
+    /**
+     * @brief Select the band-limited table of one voice for its frequency and the current type
+     * @param voice Oscillator slot
+     */
+    void updateTable(int voice);
+
+    // LFO rates relative to the oscillator phase, as used by OscillatorUtils::getOscSample()
+    static constexpr double nasalRatio = 2.7 * 440.0 / 44100.0; ///< Nasal LFO rate per oscillator cycle
+    static constexpr double vibratoRatio = 0.01;                ///< Vibrato LFO rate per oscillator cycle
+
+    template <typename T>
+    using VoiceArray = std::array<T, maxVoices>; ///< One entry per voice
+
+    alignas(SIMDPhase::SIMDRegisterSize) VoiceArray<juce::uint32> phase{};        ///< Oscillator phases
+    alignas(SIMDPhase::SIMDRegisterSize) VoiceArray<juce::uint32> phaseDelta{};   ///< Oscillator increments
+    alignas(SIMDPhase::SIMDRegisterSize) VoiceArray<juce::uint32> nasalPhase{};   ///< Nasal LFO phases
+    alignas(SIMDPhase::SIMDRegisterSize) VoiceArray<juce::uint32> nasalDelta{};   ///< Nasal LFO increments
+    alignas(SIMDPhase::SIMDRegisterSize) VoiceArray<juce::uint32> vibratoPhase{}; ///< Vibrato LFO phases
+    alignas(SIMDPhase::SIMDRegisterSize) VoiceArray<juce::uint32> vibratoDelta{}; ///< Vibrato LFO increments
+
+    std::array<const float*, maxVoices> tables{};  ///< Band-limited table of each voice
+    std::array<float, maxVoices> frequencies{};    ///< Frequency of each voice in Hz
+    const WavetableBank* bank = nullptr;           ///< Table source
+    OscType oscType = OscType::Sine;               ///< Current oscillator type
+    double sampleRate = 44100.0;                   ///< Sample rate in Hz
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscillatorBank)
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include "JuceHeader.h"
+#include "magic_enum/magic_enum.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @file ParameterRegistry.hpp
+ * @brief Cached parameter handles indexed by a parameter enum
+ */
+
+/**
+ * @brief Parameter handles of a value tree state, resolved once and indexed at compile time
+ *
+ * The parameter IDs are the enum value names (as created with magic_enum), so every
+ * string lookup and dynamic_cast happens once in the constructor. Afterwards reading a
+ * parameter is a single relaxed atomic load and setting one needs no search.
+ * @tparam ParameterEnum Parameter enumeration ending with a NumParameters entry
+ */
+template <typename ParameterEnum>
+class ParameterRegistry {
+public:
+    static constexpr size_t numParameters = static_cast<size_t>(ParameterEnum::NumParameters); ///< Number of parameters
+
+    /**
+     * @brief Resolve all parameters of a value tree state
+     * @param state Value tree state holding one parameter per enum value (must outlive the registry)
+     */
+    explicit ParameterRegistry(juce::AudioProcessorValueTreeState& state) {
+        for (size_t i = 0; i < numParameters; ++i) {
+            const auto id = magic_enum::enum_name(static_cast<ParameterEnum>(i));
+            const juce::String parameterID(id.data(), id.size());
+
+            rawValues[i] = state.getRawParameterValue(parameterID);
+            parameters[i] = dynamic_cast<juce::RangedAudioParameter*>(state.getParameter(parameterID));
+            floatParameters[i] = dynamic_cast<juce::AudioParameterFloat*>(parameters[i]);
+            choiceParameters[i] = dynamic_cast<juce::AudioParameterChoice*>(parameters[i]);
+
+            jassert(rawValues[i] != nullptr && parameters[i] != nullptr); // Every enum value needs a parameter
+        }
+    }
+
+    /**
+     * @brief Read the current plain value of a parameter (safe on the audio thread)
+     * @return Parameter value in its own range
+     */
+    template <ParameterEnum Param>
+    float load() const noexcept {
+        return rawValues[index<Param>()]->load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the typed handle of a float parameter
+     * @return Parameter, or nullptr if Param is not an AudioParameterFloat
+     */
+    template <ParameterEnum Param>
+    juce::AudioParameterFloat* getFloat() const noexcept {
+        return floatParameters[index<Param>()];
+    }
+
+    /**
+     * @brief Get the typed handle of a choice parameter
+     * @return Parameter, or nullptr if Param is not an AudioParameterChoice
+     */
+    template <ParameterEnum Param>
+    juce::AudioParameterChoice* getChoice() const noexcept {
+        return choiceParameters[index<Param>()];
+    }
+
+    /**
+     * @brief Set a parameter from a plain value and notify the host (message thread only)
+     * @param plainValue Value in the range of the parameter
+     */
+    template <ParameterEnum Param>
+    void setValueNotifyingHost(float plainValue) const {
+        auto* parameter = parameters[index<Param>()];
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+    }
+
+private:
+    /**
+     * @brief Get the array index of an enum value
+     * @return Index (checked at compile time)
+     */
+    template <ParameterEnum Param>
+    static constexpr size_t index() noexcept {
+        static_assert(static_cast<size_t>(Param) < numParameters, "Not a parameter");
+        return static_cast<size_t>(Param);
+    }
+
+    std::array<std::atomic<float>*, numParameters> rawValues{};               ///< Raw parameter values
+    std::array<juce::RangedAudioParameter*, numParameters> parameters{};      ///< Parameter objects
+    std::array<juce::AudioParameterFloat*, numParameters> floatParameters{};  ///< Float handles (nullptr otherwise)
+    std::array<juce::AudioParameterChoice*, numParameters> choiceParameters{}; ///< Choice handles (nullptr otherwise)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterRegistry)
+};
@@ -137,6 +137,15 @@ AvSynthAudioProcessorEditor::AvSynthAudioProcessorEditor(AvSynthAudioProcessor &
       reverbSlider(juce::Slider::LinearVertical, juce::Slider::TextEntryBoxPosition::TextBoxBelow),
       reverbAttachment(p.parameters, magic_enum::enum_name<AvSynthAudioProcessor::Parameters::ReverbAmount>().data(), reverbSlider),
 
+      reverbModeComboBox(),
+      reverbModeAttachment(p.parameters, magic_enum::enum_name<AvSynthAudioProcessor::Parameters::ReverbMode>().data(), reverbModeComboBox),
+
+      headTrimSlider(juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow),
+      headTrimAttachment(p.parameters, magic_enum::enum_name<AvSynthAudioProcessor::Parameters::ConvolutionHeadTrim>().data(), headTrimSlider),
+
+      tailLengthSlider(juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow),
+      tailLengthAttachment(p.parameters, magic_enum::enum_name<AvSynthAudioProcessor::Parameters::ConvolutionTailLength>().data(), tailLengthSlider),
+
       bitCrusherSlider(juce::Slider::LinearVertical, juce::Slider::TextBoxBelow),
       bitCrusherAttachment(p.parameters, magic_enum::enum_name<AvSynthAudioProcessor::Parameters::BitCrusherRate>().data(), bitCrusherSlider),
 
@@ -148,8 +157,9 @@ AvSynthAudioProcessorEditor::AvSynthAudioProcessorEditor(AvSynthAudioProcessor &
 
       // Initialize interactive components
       keyboardComponent(p.keyboardState, juce::MidiKeyboardComponent::horizontalKeyboard),
-      waveformComponent(p.circularBuffer.getBuffer(), p.bufferWritePos),
-      vuMeterComponent() {
+      waveformComponent(p.waveformSnapshots),
+      vuMeterComponent(),
+      frameScheduler(*this, [this] { onFrame(); }) {
 
     juce::ignoreUnused(processorRef);
 
@@ -180,8 +190,18 @@ AvSynthAudioProcessorEditor::AvSynthAudioProcessorEditor(AvSynthAudioProcessor &
     // Setup ComboBox with oscillator choices
     setupOscillatorComboBox();
 
+    // Setup ComboBox with reverb engine choices
+    setupReverbModeComboBox();
+
+    // Setup convolution reverb controls
+    setupImpulseResponseControls();
+
     // Add listeners
     oscTypeComboBox.addListener(this);
+    for (const auto parameter : WATCHED_PARAMETERS) {
+        const auto id = magic_enum::enum_name(parameter);
+        processorRef.parameters.addParameterListener(juce::String(id.data(), id.size()), this);
+    }
 
     // Set initial color theme and image
     currentOscType = oscTypeComboBox.getSelectedItemIndex();
@@ -191,16 +211,16 @@ AvSynthAudioProcessorEditor::AvSynthAudioProcessorEditor(AvSynthAudioProcessor &
     // Add all components to the editor
     addAndMakeVisibleComponents();
 
-    // Start timer for UI updates
-    startTimer(TIMER_INTERVAL_MS);
-
     // Set initial size
     setSize(650, 720);
     setResizable(true, true);
 }
 
 AvSynthAudioProcessorEditor::~AvSynthAudioProcessorEditor() {
-    stopTimer();
+    for (const auto parameter : WATCHED_PARAMETERS) {
+        const auto id = magic_enum::enum_name(parameter);
+        processorRef.parameters.removeParameterListener(juce::String(id.data(), id.size()), this);
+    }
     setLookAndFeel(nullptr);
 }
 
@@ -221,6 +241,14 @@ void AvSynthAudioProcessorEditor::setupLabels() {
     reverbLabel.setJustificationType(juce::Justification::centred);
     reverbLabel.setColour(juce::Label::textColourId, juce::Colours::white);
 
+    headTrimLabel.setText("IR Head", juce::dontSendNotification);
+    headTrimLabel.setJustificationType(juce::Justification::centred);
+    headTrimLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+
+    tailLengthLabel.setText("IR Tail", juce::dontSendNotification);
+    tailLengthLabel.setJustificationType(juce::Justification::centred);
+    tailLengthLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+
     bitCrusherLabel.setText("BitCrusher", juce::dontSendNotification);
     bitCrusherLabel.setJustificationType(juce::Justification::centred);
     bitCrusherLabel.setColour(juce::Label::textColourId, juce::Colours::white);
@@ -249,36 +277,21 @@ void AvSynthAudioProcessorEditor::setupPresetButtons() {
 void AvSynthAudioProcessorEditor::setupADSRComponent() {
     // Set up ADSR component callback
     adsrComponent.onParameterChanged = [this](float attack, float decay, float sustain, float release) {
-        // Set parameter values directly in the ValueTreeState
-        auto* attackParam = processorRef.parameters.getParameter(
-            magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Attack>().data());
-        auto* decayParam = processorRef.parameters.getParameter(
-            magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Decay>().data());
-        auto* sustainParam = processorRef.parameters.getParameter(
-            magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Sustain>().data());
-        auto* releaseParam = processorRef.parameters.getParameter(
-            magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Release>().data());
-
-        // Set parameters with normalized values
-        if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(attackParam)) {
-            float normalizedValue = floatParam->convertTo0to1(attack);
-            floatParam->setValueNotifyingHost(normalizedValue);
-        }
-
-        if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(decayParam)) {
-            float normalizedValue = floatParam->convertTo0to1(decay);
-            floatParam->setValueNotifyingHost(normalizedValue);
-        }
-
-        if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(sustainParam)) {
-            float normalizedValue = floatParam->convertTo0to1(sustain);
-            floatParam->setValueNotifyingHost(normalizedValue);
-        }
+        // Set parameter values through the cached handles
+        const auto& registry = processorRef.parameterRegistry;
+        registry.setValueNotifyingHost<AvSynthAudioProcessor::Parameters::Attack>(attack);
+        registry.setValueNotifyingHost<AvSynthAudioProcessor::Parameters::Decay>(decay);
+        registry.setValueNotifyingHost<AvSynthAudioProcessor::Parameters::Sustain>(sustain);
+        registry.setValueNotifyingHost<AvSynthAudioProcessor::Parameters::Release>(release);
+    };
 
-        if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(releaseParam)) {
-            float normalizedValue = floatParam->convertTo0to1(release);
-            floatParam->setValueNotifyingHost(normalizedValue);
-        }
+    adsrComponent.onCurveShapesChanged = [this](ADSREnvelope::CurveShape attack, ADSREnvelope::CurveShape decay,
+                                                ADSREnvelope::CurveShape release) {
+        // Choice parameters take the index of the shape as plain value
+        const auto& registry = processorRef.parameterRegistry;
+        registry.setValueNotifyingHost<AvSynthAudioProcessor::Parameters::AttackCurve>(static_cast<float>(attack));
+        registry.setValueNotifyingHost<AvSynthAudioProcessor::Parameters::DecayCurve>(static_cast<float>(decay));
+        registry.setValueNotifyingHost<AvSynthAudioProcessor::Parameters::ReleaseCurve>(static_cast<float>(release));
     };
 
     // Initialize ADSR component with current values
@@ -290,9 +303,7 @@ void AvSynthAudioProcessorEditor::setupOscillatorComboBox() {
     oscTypeComboBox.setJustificationType(juce::Justification::centredLeft);
     oscTypeComboBox.setColour(juce::ComboBox::textColourId, juce::Colours::white);
     oscTypeComboBox.setColour(juce::ComboBox::backgroundColourId, juce::Colours::transparentBlack);
-    auto* oscTypeParam = dynamic_cast<juce::AudioParameterChoice*>(
-        processorRef.parameters.getParameter(
-            magic_enum::enum_name<AvSynthAudioProcessor::Parameters::OscType>().data()));
+    auto* oscTypeParam = processorRef.parameterRegistry.getChoice<AvSynthAudioProcessor::Parameters::OscType>();
 
     if (oscTypeParam != nullptr) {
         oscTypeComboBox.clear();
@@ -304,6 +315,56 @@ void AvSynthAudioProcessorEditor::setupOscillatorComboBox() {
     }
 }
 
+void AvSynthAudioProcessorEditor::setupReverbModeComboBox() {
+    // Setup ComboBox with reverb engine choices
+    reverbModeComboBox.setJustificationType(juce::Justification::centred);
+    reverbModeComboBox.setColour(juce::ComboBox::textColourId, juce::Colours::white);
+    reverbModeComboBox.setColour(juce::ComboBox::backgroundColourId, juce::Colours::transparentBlack);
+    auto* reverbModeParam = processorRef.parameterRegistry.getChoice<AvSynthAudioProcessor::Parameters::ReverbMode>();
+
+    if (reverbModeParam != nullptr) {
+        reverbModeComboBox.clear();
+        const auto& choices = reverbModeParam->choices;
+        for (int i = 0; i < choices.size(); ++i) {
+            reverbModeComboBox.addItem(choices[i], i + 1);
+        }
+        reverbModeComboBox.setSelectedId(reverbModeParam->getIndex() + 1, juce::dontSendNotification);
+    }
+}
+
+void AvSynthAudioProcessorEditor::setupImpulseResponseControls() {
+    impulseResponseButton.addListener(this);
+    impulseResponseButton.setColour(juce::TextButton::buttonColourId, juce::Colours::black.withAlpha(0.7f));
+    updateImpulseResponseButton();
+
+    headTrimSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 16);
+    headTrimSlider.setTextValueSuffix(" ms");
+    tailLengthSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 16);
+    tailLengthSlider.setTextValueSuffix(" s");
+}
+
+void AvSynthAudioProcessorEditor::chooseImpulseResponse() {
+    impulseResponseChooser = std::make_unique<juce::FileChooser>(
+        "Load Impulse Response", processorRef.getImpulseResponseFile().getParentDirectory(), "*.wav;*.aif;*.aiff;*.flac");
+
+    // Asynchronous, so the message thread keeps running while the chooser is open
+    impulseResponseChooser->launchAsync(
+        juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+        [this](const juce::FileChooser& chooser) {
+            const auto file = chooser.getResult();
+            if (file.existsAsFile()) {
+                processorRef.loadImpulseResponse(file);
+                updateImpulseResponseButton();
+            }
+        });
+}
+
+void AvSynthAudioProcessorEditor::updateImpulseResponseButton() {
+    const auto& file = processorRef.getImpulseResponseFile();
+    shownImpulseResponseFile = file;
+    impulseResponseButton.setButtonText(file == juce::File() ? juce::String("Load IR") : file.getFileNameWithoutExtension());
+}
+
 void AvSynthAudioProcessorEditor::addAndMakeVisibleComponents() {
     // Add all components and make them visible
     for (auto* component : getComponents()) {
@@ -312,6 +373,12 @@ void AvSynthAudioProcessorEditor::addAndMakeVisibleComponents() {
 
     addAndMakeVisible(oscImage);
     addAndMakeVisible(reverbLabel);
+    addAndMakeVisible(reverbModeComboBox);
+    addAndMakeVisible(impulseResponseButton);
+    addAndMakeVisible(headTrimSlider);
+    addAndMakeVisible(headTrimLabel);
+    addAndMakeVisible(tailLengthSlider);
+    addAndMakeVisible(tailLengthLabel);
     addAndMakeVisible(bitCrusherSlider);
     addAndMakeVisible(bitCrusherLabel);
     addAndMakeVisible(gainLabel);
@@ -386,6 +453,16 @@ void AvSynthAudioProcessorEditor::resized() {
     // Reverb slider (vertical, right side)
     auto reverbLabelArea = reverbArea.removeFromTop(20);
     reverbLabel.setBounds(reverbLabelArea);
+
+    // Convolution controls below the reverb slider
+    auto tailLengthArea = reverbArea.removeFromBottom(76);
+    tailLengthLabel.setBounds(tailLengthArea.removeFromTop(16));
+    tailLengthSlider.setBounds(tailLengthArea);
+    auto headTrimArea = reverbArea.removeFromBottom(76);
+    headTrimLabel.setBounds(headTrimArea.removeFromTop(16));
+    headTrimSlider.setBounds(headTrimArea);
+    impulseResponseButton.setBounds(reverbArea.removeFromBottom(24).reduced(2, 0));
+    reverbModeComboBox.setBounds(reverbArea.removeFromBottom(24).reduced(2, 0));
     reverbSlider.setBounds(reverbArea.reduced(10));
 
     auto bitCrusherLabelArea = bitCrusherArea.removeFromTop(20);
@@ -422,8 +499,10 @@ void AvSynthAudioProcessorEditor::resized() {
 void AvSynthAudioProcessorEditor::comboBoxChanged(juce::ComboBox *comboBoxThatHasChanged) {
     if (comboBoxThatHasChanged == &oscTypeComboBox) {
         int newOscType = oscTypeComboBox.getSelectedItemIndex();
-        updateColorTheme(newOscType);
-        updateOscImage(newOscType);
+        if (newOscType != currentOscType) {
+            updateColorTheme(newOscType);
+            updateOscImage(newOscType);
+        }
     }
 }
 
@@ -436,61 +515,60 @@ void AvSynthAudioProcessorEditor::buttonClicked(juce::Button* button) {
         loadToadPreset(2);
     } else if (button == &toadPreset4Button) {
         loadToadPreset(3);
+    } else if (button == &impulseResponseButton) {
+        chooseImpulseResponse();
     }
 }
 
-void AvSynthAudioProcessorEditor::timerCallback() {
-    // Update ADSR plotter with current values
-    float currentValue = processorRef.getCurrentEnvelopeValue();
-    bool isActive = processorRef.isEnvelopeActive();
-    int state = processorRef.getADSRState();
+void AvSynthAudioProcessorEditor::parameterChanged(const juce::String& parameterID, float newValue) {
+    juce::ignoreUnused(newValue);
 
-    adsrComponent.updateEnvelopeValue(currentValue, isActive);
-    adsrComponent.setADSRState(state);
+    // Host automation calls this on the audio thread, so only flag the change for the next frame
+    if (parameterID == magic_enum::enum_name<AvSynthAudioProcessor::Parameters::OscType>().data()) {
+        oscTypeDirty.store(true);
+    } else {
+        envelopeParametersDirty.store(true);
+    }
+}
 
-    updateVUMeter();
+void AvSynthAudioProcessorEditor::onFrame() {
+    // One telemetry snapshot per frame, shared by all views
+    const auto telemetry = processorRef.getUITelemetry();
 
-    // Synchronize ADSR component with current parameter values
-    updateUIFromParameters();
-}
+    // Update ADSR plotter while the envelope runs (and once more when it stops)
+    if (telemetry.envelopeActive || envelopeWasActive) {
+        adsrComponent.updateEnvelopeValue(telemetry.envelopeValue, telemetry.envelopeActive);
+        adsrComponent.setADSRState(telemetry.adsrState);
+        envelopeWasActive = telemetry.envelopeActive;
+    }
+    adsrComponent.advanceFrame();
 
-//==============================================================================
-// Utility Methods
+    updateVUMeter(telemetry);
+    vuMeterComponent.advanceFrame();
 
-void AvSynthAudioProcessorEditor::updateVUMeter() {
-    // Get current audio levels from processor
-    auto& buffer = processorRef.circularBuffer.getBuffer();
-    if (buffer.getNumChannels() > 0 && buffer.getNumSamples() > 0) {
-        // Calculate RMS levels for left and right channels
-        float leftLevel = 0.0f;
-        float rightLevel = 0.0f;
-
-        const int numSamples = juce::jmin(buffer.getNumSamples(), 512); // Limit for performance
-
-        // Left channel
-        if (buffer.getNumChannels() >= 1) {
-            const float* leftData = buffer.getReadPointer(0);
-            float sum = 0.0f;
-            for (int i = 0; i < numSamples; ++i) {
-                sum += leftData[i] * leftData[i];
-            }
-            leftLevel = std::sqrt(sum / numSamples);
-        }
+    waveformComponent.refresh();
 
-        // Right channel (use left if mono)
-        if (buffer.getNumChannels() >= 2) {
-            const float* rightData = buffer.getReadPointer(1);
-            float sum = 0.0f;
-            for (int i = 0; i < numSamples; ++i) {
-                sum += rightData[i] * rightData[i];
-            }
-            rightLevel = std::sqrt(sum / numSamples);
-        } else {
-            rightLevel = leftLevel; // Mono signal
-        }
+    // Synchronize the UI with parameters changed by the host or a preset
+    applyParameterChanges();
 
-        vuMeterComponent.updateLevels(leftLevel, rightLevel);
+    // A restored plugin state can load a different impulse response while the editor is open
+    if (processorRef.getImpulseResponseFile() != shownImpulseResponseFile) {
+        updateImpulseResponseButton();
     }
+
+    // Nothing sounds and every view has settled: poll at the idle rate until something happens
+    frameScheduler.setIdle(!telemetry.envelopeActive && telemetry.numActiveVoices == 0
+                           && vuMeterComponent.isSettled());
+}
+
+//==============================================================================
+// Utility Methods
+
+void AvSynthAudioProcessorEditor::updateVUMeter(const AvSynthAudioProcessor::UITelemetry& telemetry) {
+    // Levels are measured on the audio thread and read once per frame
+    vuMeterComponent.updateLevels(telemetry.left.rms, telemetry.right.rms);
+    vuMeterComponent.updatePeaks(telemetry.left.truePeak, telemetry.right.truePeak);
+    vuMeterComponent.updateLoudness(telemetry.loudness);
 }
 
 void AvSynthAudioProcessorEditor::updateColorTheme(int oscTypeIndex) {
@@ -532,17 +610,8 @@ void AvSynthAudioProcessorEditor::updateColorTheme(int oscTypeIndex) {
     vowelMorphLabel.setColour(juce::Label::textColourId, juce::Colours::white);
     presetLabel.setColour(juce::Label::textColourId, juce::Colours::white);
 
+    // Repainting the editor also repaints every child in its area
     repaint();
-
-    // Repaint all sliders
-    for (auto* comp : getComponents()) {
-        comp->repaint();
-    }
-
-    toadPreset1Button.repaint();
-    toadPreset2Button.repaint();
-    toadPreset3Button.repaint();
-    toadPreset4Button.repaint();
 }
 
 void AvSynthAudioProcessorEditor::updateOscImage(int oscTypeIndex) {
@@ -581,40 +650,34 @@ void AvSynthAudioProcessorEditor::updateOscImage(int oscTypeIndex) {
 }
 
 void AvSynthAudioProcessorEditor::loadToadPreset(int presetIndex) {
-    if (processorRef.loadPreset(presetIndex)) {
-        // Update UI to reflect the loaded preset
-        updateColorTheme(processorRef.getPresetManager().getPreset(presetIndex)->oscType);
-        updateOscImage(processorRef.getPresetManager().getPreset(presetIndex)->oscType);
-    }
+    // The parameter listener updates the theme, image and ADSR view on the next frame
+    processorRef.loadPreset(presetIndex);
 }
 
 void AvSynthAudioProcessorEditor::updateUIFromParameters() {
-    static float lastAttack = -1.0f, lastDecay = -1.0f, lastSustain = -1.0f, lastRelease = -1.0f;
-
-    float currentAttack = processorRef.parameters.getRawParameterValue(
-        magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Attack>().data())->load();
-    float currentDecay = processorRef.parameters.getRawParameterValue(
-        magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Decay>().data())->load();
-    float currentSustain = processorRef.parameters.getRawParameterValue(
-        magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Sustain>().data())->load();
-    float currentRelease = processorRef.parameters.getRawParameterValue(
-        magic_enum::enum_name<AvSynthAudioProcessor::Parameters::Release>().data())->load();
-
-    // Only update if values have changed
-    if (!juce::approximatelyEqual(currentAttack, lastAttack) ||
-        !juce::approximatelyEqual(currentDecay, lastDecay) ||
-        !juce::approximatelyEqual(currentSustain, lastSustain) ||
-        !juce::approximatelyEqual(currentRelease, lastRelease)) {
-
-        adsrComponent.setAttack(currentAttack);
-        adsrComponent.setDecay(currentDecay);
-        adsrComponent.setSustain(currentSustain);
-        adsrComponent.setRelease(currentRelease);
-
-        lastAttack = currentAttack;
-        lastDecay = currentDecay;
-        lastSustain = currentSustain;
-        lastRelease = currentRelease;
+    const auto& registry = processorRef.parameterRegistry;
+    adsrComponent.setAttack(registry.load<AvSynthAudioProcessor::Parameters::Attack>());
+    adsrComponent.setDecay(registry.load<AvSynthAudioProcessor::Parameters::Decay>());
+    adsrComponent.setSustain(registry.load<AvSynthAudioProcessor::Parameters::Sustain>());
+    adsrComponent.setRelease(registry.load<AvSynthAudioProcessor::Parameters::Release>());
+
+    const auto toCurveShape = [](float index) { return static_cast<ADSREnvelope::CurveShape>(juce::roundToInt(index)); };
+    adsrComponent.setCurveShapes(toCurveShape(registry.load<AvSynthAudioProcessor::Parameters::AttackCurve>()),
+                                 toCurveShape(registry.load<AvSynthAudioProcessor::Parameters::DecayCurve>()),
+                                 toCurveShape(registry.load<AvSynthAudioProcessor::Parameters::ReleaseCurve>()));
+}
+
+void AvSynthAudioProcessorEditor::applyParameterChanges() {
+    if (envelopeParametersDirty.exchange(false)) {
+        updateUIFromParameters();
+    }
+
+    if (oscTypeDirty.exchange(false)) {
+        const int newOscType = juce::roundToInt(processorRef.parameterRegistry.load<AvSynthAudioProcessor::Parameters::OscType>());
+        if (newOscType != currentOscType) {
+            updateColorTheme(newOscType);
+            updateOscImage(newOscType);
+        }
     }
 }
 
@@ -5,6 +5,7 @@
 #include "ADSRComponent.hpp"
 #include "PresetManager.hpp"
 #include "VUMeterComponent.hpp"
+#include "FrameScheduler.hpp"
 
 /**
  * @file PluginEditor.hpp
@@ -88,7 +89,7 @@ private:
 class AvSynthAudioProcessorEditor final : public juce::AudioProcessorEditor,
                                           public juce::ComboBox::Listener,
                                           public juce::Button::Listener,
-                                          public juce::Timer {
+                                          private juce::AudioProcessorValueTreeState::Listener {
 public:
     /**
      * @brief Constructor
@@ -135,9 +136,11 @@ public:
     void buttonClicked(juce::Button* button) override;
 
     /**
-     * @brief Timer callback for regular UI updates
+     * @brief Flag a watched parameter as changed (may be called on any thread)
+     * @param parameterID ID of the changed parameter
+     * @param newValue New parameter value
      */
-    void timerCallback() override;
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
 
     //==============================================================================
     // Public utility methods
@@ -176,10 +179,16 @@ private:
      */
     std::vector<juce::Component *> getComponents();
 
+    /**
+     * @brief Run one UI frame: read the processor telemetry and update the views that changed
+     */
+    void onFrame();
+
     /**
      * @brief Update VU meter with current audio levels
+     * @param telemetry Telemetry of this frame
      */
-    void updateVUMeter();
+    void updateVUMeter(const AvSynthAudioProcessor::UITelemetry& telemetry);
 
     /**
      * @brief Setup preset buttons with proper styling and listeners
@@ -200,10 +209,37 @@ private:
     void setupOscillatorComboBox();
 
     /**
-     * @brief Update UI components to reflect current parameter values
+     * @brief Setup the reverb mode ComboBox with the engine choices
+     */
+    void setupReverbModeComboBox();
+
+    /**
+     * @brief Setup the impulse response button and the trim controls of the convolution reverb
+     */
+    void setupImpulseResponseControls();
+
+    /**
+     * @brief Open a file chooser and load the selected impulse response
+     */
+    void chooseImpulseResponse();
+
+    /**
+     * @brief Show the name of the current impulse response on its button
+     *
+     * Called when the editor loads a file, and from onFrame() when the processor's file changed.
+     */
+    void updateImpulseResponseButton();
+
+    /**
+     * @brief Update the ADSR component to reflect the current envelope parameters
      */
     void updateUIFromParameters();
 
+    /**
+     * @brief Apply the parameter changes flagged since the previous frame
+     */
+    void applyParameterChanges();
+
     //==============================================================================
     // Member variables
 
@@ -230,6 +266,21 @@ private:
     juce::AudioProcessorValueTreeState::SliderAttachment reverbAttachment; ///< Reverb parameter attachment
     juce::Label reverbLabel;                                                ///< Reverb control label
 
+    juce::ComboBox reverbModeComboBox;                                              ///< Reverb engine selector
+    juce::AudioProcessorValueTreeState::ComboBoxAttachment reverbModeAttachment; ///< Reverb engine attachment
+
+    juce::Slider headTrimSlider;                                              ///< Impulse response head trim control
+    juce::AudioProcessorValueTreeState::SliderAttachment headTrimAttachment; ///< Head trim attachment
+    juce::Label headTrimLabel;                                                ///< Head trim label
+
+    juce::Slider tailLengthSlider;                                              ///< Impulse response tail length control
+    juce::AudioProcessorValueTreeState::SliderAttachment tailLengthAttachment; ///< Tail length attachment
+    juce::Label tailLengthLabel;                                                ///< Tail length label
+
+    juce::TextButton impulseResponseButton;                  ///< Opens the impulse response file chooser
+    std::unique_ptr<juce::FileChooser> impulseResponseChooser; ///< File chooser while it is open
+    juce::File shownImpulseResponseFile;                       ///< Impulse response named on the button
+
     juce::Slider bitCrusherSlider;                                              ///< Bit crusher control
     juce::AudioProcessorValueTreeState::SliderAttachment bitCrusherAttachment; ///< Bit crusher attachment
     juce::Label bitCrusherLabel;                                                ///< Bit crusher label
@@ -257,8 +308,16 @@ private:
     juce::Colour secondaryColor = juce::Colours::darkred; ///< Current secondary theme color
 
     // UI update optimization
-    static constexpr int UI_UPDATE_RATE_HZ = 30; ///< UI update rate in Hz
-    static constexpr int TIMER_INTERVAL_MS = 1000 / UI_UPDATE_RATE_HZ; ///< Timer interval in milliseconds
+    /// Parameters whose changes update the UI beyond their attached controls
+    static constexpr std::array<AvSynthAudioProcessor::Parameters, 8> WATCHED_PARAMETERS{
+        AvSynthAudioProcessor::Parameters::OscType, AvSynthAudioProcessor::Parameters::Attack,
+        AvSynthAudioProcessor::Parameters::Decay, AvSynthAudioProcessor::Parameters::Sustain,
+        AvSynthAudioProcessor::Parameters::Release, AvSynthAudioProcessor::Parameters::AttackCurve,
+        AvSynthAudioProcessor::Parameters::DecayCurve, AvSynthAudioProcessor::Parameters::ReleaseCurve};
+    std::atomic<bool> envelopeParametersDirty{false}; ///< ADSR parameters changed since the last frame
+    std::atomic<bool> oscTypeDirty{false};            ///< Oscillator type changed since the last frame
+    bool envelopeWasActive = false; ///< Envelope activity shown in the previous frame
+    FrameScheduler frameScheduler;  ///< Drives all view updates (declared last, stops first)
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AvSynthAudioProcessorEditor)
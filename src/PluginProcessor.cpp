@@ -15,21 +15,24 @@ static std::unique_ptr<ParamT> makeParameter(Args &&...args) {
 // ChainSettings Implementation
 
 AvSynthAudioProcessor::ChainSettings
-AvSynthAudioProcessor::ChainSettings::Get(const juce::AudioProcessorValueTreeState &parameters) {
+AvSynthAudioProcessor::ChainSettings::Get(const ParameterRegistry<Parameters> &registry) {
     ChainSettings settings{};
 
-    // Load parameter values using magic_enum to convert enum to string
-    settings.gain = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::Gain>().data())->load();
-    settings.frequency = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::Frequency>().data())->load();
-    settings.oscType = static_cast<OscType>(
-        static_cast<int>(parameters.getRawParameterValue(magic_enum::enum_name<Parameters::OscType>().data())->load()));
-    settings.VowelMorph = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::VowelMorph>().data())->load();
-    settings.reverbAmount = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::ReverbAmount>().data())->load();
-    settings.bitCrusherRate = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::BitCrusherRate>().data())->load();
-    settings.attack = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::Attack>().data())->load();
-    settings.decay = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::Decay>().data())->load();
-    settings.sustain = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::Sustain>().data())->load();
-    settings.release = parameters.getRawParameterValue(magic_enum::enum_name<Parameters::Release>().data())->load();
+    // One relaxed atomic load per parameter, the handles were resolved in the constructor
+    settings.gain = registry.load<Parameters::Gain>();
+    settings.frequency = registry.load<Parameters::Frequency>();
+    settings.oscType = static_cast<OscType>(static_cast<int>(registry.load<Parameters::OscType>()));
+    settings.VowelMorph = registry.load<Parameters::VowelMorph>();
+    settings.reverbAmount = registry.load<Parameters::ReverbAmount>();
+    settings.reverbMode = static_cast<::ReverbMode>(static_cast<int>(registry.load<Parameters::ReverbMode>()));
+    settings.bitCrusherRate = registry.load<Parameters::BitCrusherRate>();
+    settings.attack = registry.load<Parameters::Attack>();
+    settings.decay = registry.load<Parameters::Decay>();
+    settings.sustain = registry.load<Parameters::Sustain>();
+    settings.release = registry.load<Parameters::Release>();
+    settings.attackCurve = static_cast<ADSREnvelope::CurveShape>(static_cast<int>(registry.load<Parameters::AttackCurve>()));
+    settings.decayCurve = static_cast<ADSREnvelope::CurveShape>(static_cast<int>(registry.load<Parameters::DecayCurve>()));
+    settings.releaseCurve = static_cast<ADSREnvelope::CurveShape>(static_cast<int>(registry.load<Parameters::ReleaseCurve>()));
 
     return settings;
 }
@@ -47,10 +50,26 @@ AvSynthAudioProcessor::AvSynthAudioProcessor()
 #endif
       ),
       parameters(*this, nullptr, "Parameters", createParameterLayout()),
-      circularBuffer(1, 1024) {
+      parameterRegistry(parameters),
+      impulseResponseLoader([this](juce::AudioBuffer<float>&& impulseResponse, double sampleRate) {
+          effectsChain.getReverb().loadImpulseResponse(std::move(impulseResponse), sampleRate);
+      }) {
+    startTimerHz(NOTE_QUEUE_RATE_HZ);
+
+    for (const auto parameter : IMPULSE_RESPONSE_TRIM_PARAMETERS) {
+        const auto id = magic_enum::enum_name(parameter);
+        parameters.addParameterListener(juce::String(id.data(), id.size()), this);
+    }
 }
 
-AvSynthAudioProcessor::~AvSynthAudioProcessor() = default;
+AvSynthAudioProcessor::~AvSynthAudioProcessor() {
+    for (const auto parameter : IMPULSE_RESPONSE_TRIM_PARAMETERS) {
+        const auto id = magic_enum::enum_name(parameter);
+        parameters.removeParameterListener(juce::String(id.data(), id.size()), this);
+    }
+    cancelPendingUpdate();
+    stopTimer();
+}
 
 //==============================================================================
 // AudioProcessor Implementation
@@ -84,7 +103,9 @@ bool AvSynthAudioProcessor::isMidiEffect() const {
 }
 
 double AvSynthAudioProcessor::getTailLengthSeconds() const {
-    return 0.0;
+    // Hosts keep processing this long after the last input, so the reverb can ring out
+    const auto reverbMode = static_cast<::ReverbMode>(static_cast<int>(parameterRegistry.load<Parameters::ReverbMode>()));
+    return effectsChain.getReverb().getTailLengthSeconds(reverbMode, parameterRegistry.load<Parameters::ReverbAmount>());
 }
 
 int AvSynthAudioProcessor::getNumPrograms() {
@@ -116,53 +137,50 @@ void AvSynthAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     juce::ignoreUnused(sampleRate);
 
     // Initialize previous settings
-    previousChainSettings = ChainSettings::Get(parameters);
-
-    // Setup circular buffer for visualization
-    circularBuffer.setSize(1, samplesPerBlock);
-
-    // Initialize oscillator
-    updateAngleDelta(previousChainSettings.frequency);
+    previousChainSettings = ChainSettings::Get(parameterRegistry);
 
     // Prepare effects chain
     effectsChain.prepare(sampleRate, samplesPerBlock, 2); // Stereo for reverb
+    effectsChain.getReverb().setMode(previousChainSettings.reverbMode);
 
-    // Setup ADSR envelope
-    envelope.setSampleRate(sampleRate);
+    // Allocate and prepare the voice pool (never resized on the audio thread)
     ADSREnvelope::Parameters adsrParams(
         previousChainSettings.attack,
         previousChainSettings.decay,
         previousChainSettings.sustain,
-        previousChainSettings.release
+        previousChainSettings.release,
+        previousChainSettings.attackCurve,
+        previousChainSettings.decayCurve,
+        previousChainSettings.releaseCurve
     );
-    envelope.setParameters(adsrParams);
-
-    // Setup level filters for VU meter
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = 1;
-
-    leftLevelFilter.prepare(spec);
-    rightLevelFilter.prepare(spec);
-
-    // Configure ballistics for realistic VU meter behavior
-    leftLevelFilter.setLevelCalculationType(juce::dsp::BallisticsFilterLevelCalculationType::RMS);
-    leftLevelFilter.setAttackTime(10.0f);   // Fast attack (10ms)
-    leftLevelFilter.setReleaseTime(300.0f); // Slower release (300ms)
-
-    rightLevelFilter.setLevelCalculationType(juce::dsp::BallisticsFilterLevelCalculationType::RMS);
-    rightLevelFilter.setAttackTime(10.0f);
-    rightLevelFilter.setReleaseTime(300.0f);
+    voicePool.setEnvelopeParameters(adsrParams);
+
+    // Band-limit the oscillator tables for this sample rate before the voices use them
+    wavetableBank.prepare(sampleRate);
+    voicePool.prepare(sampleRate, samplesPerBlock, wavetableBank, VoicePool::maxVoices);
+
+    // Start the waveform view from silence
+    waveformHistory.setSize(1, WAVEFORM_HISTORY_SIZE);
+    waveformHistory.getBuffer().clear();
+    waveformSamplesWritten += WAVEFORM_HISTORY_SIZE; // Gap after the cleared history, so the view rebuilds
+    publishedWaveformShape = {};
+
+    // Start the parameter smoothers at the current values
+    gainSmoother.prepare(sampleRate, samplesPerBlock, SMOOTHING_TIME_SECONDS, previousChainSettings.gain);
+    vowelMorphSmoother.prepare(sampleRate, samplesPerBlock, SMOOTHING_TIME_SECONDS, previousChainSettings.VowelMorph);
+    reverbAmountSmoother.prepare(sampleRate, samplesPerBlock, SMOOTHING_TIME_SECONDS, previousChainSettings.reverbAmount);
+    bitCrusherRateSmoother.prepare(sampleRate, samplesPerBlock, SMOOTHING_TIME_SECONDS, previousChainSettings.bitCrusherRate);
+
+    // Setup output metering for VU meter
+    levelMeter.prepare(sampleRate, samplesPerBlock);
 }
 
 void AvSynthAudioProcessor::releaseResources() {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
     effectsChain.reset();
-    envelope.reset();
-    leftLevelFilter.reset();
-    rightLevelFilter.reset();
+    voicePool.reset();
+    levelMeter.reset();
 }
 
 bool AvSynthAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const {
@@ -197,238 +215,278 @@ void AvSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     const int numSamples = buffer.getNumSamples();
 
     // Get current settings
-    const auto chainSettings = ChainSettings::Get(parameters);
+    const auto chainSettings = ChainSettings::Get(parameterRegistry);
 
     // Update ADSR parameters if changed
     if (!juce::approximatelyEqual(chainSettings.attack, previousChainSettings.attack) ||
         !juce::approximatelyEqual(chainSettings.decay, previousChainSettings.decay) ||
         !juce::approximatelyEqual(chainSettings.sustain, previousChainSettings.sustain) ||
-        !juce::approximatelyEqual(chainSettings.release, previousChainSettings.release)) {
+        !juce::approximatelyEqual(chainSettings.release, previousChainSettings.release) ||
+        chainSettings.attackCurve != previousChainSettings.attackCurve ||
+        chainSettings.decayCurve != previousChainSettings.decayCurve ||
+        chainSettings.releaseCurve != previousChainSettings.releaseCurve) {
 
         ADSREnvelope::Parameters adsrParams(
             chainSettings.attack, chainSettings.decay,
-            chainSettings.sustain, chainSettings.release
+            chainSettings.sustain, chainSettings.release,
+            chainSettings.attackCurve, chainSettings.decayCurve, chainSettings.releaseCurve
         );
-        envelope.setParameters(adsrParams);
+        voicePool.setEnvelopeParameters(adsrParams);
     }
 
-    // Process MIDI and keyboard state
+    // Ramp the continuous parameters; settled ones return nullptr and take the constant path
+    gainSmoother.setTargetValue(chainSettings.gain);
+    vowelMorphSmoother.setTargetValue(chainSettings.VowelMorph);
+    reverbAmountSmoother.setTargetValue(chainSettings.reverbAmount);
+    bitCrusherRateSmoother.setTargetValue(chainSettings.bitCrusherRate);
+
+    const float* gainValues = gainSmoother.getNextBlock(numSamples);
+    const float* vowelMorphValues = vowelMorphSmoother.getNextBlock(numSamples);
+    const float* reverbAmountValues = reverbAmountSmoother.getNextBlock(numSamples);
+    const float* bitCrusherRateValues = bitCrusherRateSmoother.getNextBlock(numSamples);
+
+    // Merge on-screen keyboard events into the MIDI buffer
     keyboardState.processNextMidiBuffer(midiMessages, 0, numSamples, true);
-    processMidiMessages(midiMessages, numSamples);
 
-    // Generate audio samples
-    generateAudioSamples(buffer, numSamples, chainSettings);
+    // Generate audio samples, splitting the block at every MIDI event
+    generateAudioSamples(buffer, midiMessages, chainSettings, vowelMorphValues);
 
-    // Apply effects
-    effectsChain.processBlock(buffer, chainSettings.reverbAmount, chainSettings.bitCrusherRate);
+    // Apply effects (switching the reverb engine only does work when the mode changed)
+    effectsChain.getReverb().setMode(chainSettings.reverbMode);
+    effectsChain.processBlock(buffer, chainSettings.reverbAmount, chainSettings.bitCrusherRate,
+                              reverbAmountValues, bitCrusherRateValues);
 
     // Apply gain
-    bool gainUnchanged = juce::approximatelyEqual(chainSettings.gain, previousChainSettings.gain);
     for (int channel = 0; channel < totalNumOutputChannels; ++channel) {
-        if (gainUnchanged) {
-            buffer.applyGain(channel, 0, numSamples, chainSettings.gain);
+        if (gainValues != nullptr) {
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel), gainValues, numSamples);
         } else {
-            buffer.applyGainRamp(channel, 0, numSamples, previousChainSettings.gain, chainSettings.gain);
+            buffer.applyGain(channel, 0, numSamples, chainSettings.gain);
         }
     }
 
-    // Update audio levels for VU meter
-    updateAudioLevels(buffer, numSamples);
+    // Meter the output for the VU meter
+    levelMeter.process(buffer, numSamples);
 
     // Update visualization buffer
-    updateVisualizationBuffer(buffer, numSamples);
+    updateVisualizationBuffer(buffer, numSamples, chainSettings);
 
     // Store settings for next block
     previousChainSettings = chainSettings;
 }
 
-void AvSynthAudioProcessor::processMidiMessages(const juce::MidiBuffer& midiMessages, int numSamples) {
-    for (const auto metadata : midiMessages) {
-        const auto msg = metadata.getMessage();
+void AvSynthAudioProcessor::handleMidiMessage(const juce::MidiMessage& msg) {
+    if (msg.isNoteOn()) {
+        const auto noteFrequency = static_cast<float>(juce::MidiMessage::getMidiNoteInHertz(msg.getNoteNumber()));
+        voicePool.noteOn(msg.getNoteNumber(), noteFrequency);
 
-        if (msg.isNoteOn()) {
-            currentNoteFrequency = msg.getMidiNoteInHertz(msg.getNoteNumber());
-            noteIsActive = true;
-            envelope.noteOn();
+        // The Frequency parameter is updated on the message thread (see timerCallback);
+        // if the queue is full the display just skips this note
+        noteFrequencyQueue.push(noteFrequency);
+    }
+    else if (msg.isNoteOff()) {
+        voicePool.noteOff(msg.getNoteNumber());
+    }
+    else if (msg.isAllNotesOff() || msg.isAllSoundOff()) {
+        voicePool.allNotesOff();
+    }
+}
 
-            // Update frequency parameter (optional)
-            auto* freqParam = parameters.getParameter(magic_enum::enum_name<Parameters::Frequency>().data());
-            if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(freqParam)) {
-                float normValue = floatParam->convertTo0to1(currentNoteFrequency);
-                floatParam->setValueNotifyingHost(normValue);
-            }
+void AvSynthAudioProcessor::timerCallback() {
+    // Only the most recent note is shown, so older queued frequencies are skipped
+    float noteFrequency = 0.0f;
+    bool hasNewNote = false;
+    while (noteFrequencyQueue.pop(noteFrequency)) {
+        hasNewNote = true;
+    }
 
-            updateAngleDelta(currentNoteFrequency);
-        }
-        else if (msg.isNoteOff()) {
-            envelope.noteOff();
-        }
+    if (hasNewNote) {
+        parameterRegistry.setValueNotifyingHost<Parameters::Frequency>(noteFrequency);
     }
 }
 
-void AvSynthAudioProcessor::generateAudioSamples(juce::AudioBuffer<float>& buffer, int numSamples, const ChainSettings& chainSettings) {
-    const auto totalNumOutputChannels = getTotalNumOutputChannels();
+void AvSynthAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue) {
+    juce::ignoreUnused(parameterID, newValue);
 
-    // Generate audio if note is active or envelope is still releasing
-    if (noteIsActive || envelope.isActive()) {
-        for (int sample = 0; sample < numSamples; ++sample) {
-            // Generate base oscillator sample with vowel morphing
-            float currentSample = VowelFilter::getVowelMorphSample(
-                chainSettings.oscType,
-                static_cast<float>(currentAngle),
-                chainSettings.VowelMorph
-            );
-
-            currentAngle += angleDelta;
-
-            // Apply ADSR envelope
-            float adsrValue = envelope.getNextSample();
-            currentSample *= adsrValue;
-
-            // Update envelope value for UI (every 4th sample for performance)
-            if (sample % 4 == 0) {
-                currentEnvelopeValue.store(adsrValue);
-            }
-
-            // If envelope is no longer active, stop note
-            if (!envelope.isActive()) {
-                noteIsActive = false;
-                currentEnvelopeValue.store(0.0f);
-            }
-
-            // Write to all output channels
-            for (int channel = 0; channel < totalNumOutputChannels; ++channel) {
-                buffer.setSample(channel, sample, currentSample);
-            }
-        }
-    } else {
-        // No active note or envelope - output silence
-        buffer.clear();
-        currentEnvelopeValue.store(0.0f);
-    }
+    // Only trim parameters are listened to; the loader is not safe to call from the audio thread
+    triggerAsyncUpdate();
 }
 
-void AvSynthAudioProcessor::updateVisualizationBuffer(const juce::AudioBuffer<float>& buffer, int numSamples) {
-    if (buffer.getNumChannels() > 0) {
-        const float* channelData = buffer.getReadPointer(0);
-        for (int sample = 0; sample < numSamples; ++sample) {
-            circularBuffer.writeSample(0, channelData[sample]);
-            circularBuffer.advanceWritePosition();
-        }
-        bufferWritePos = circularBuffer.getWritePosition();
-    }
+void AvSynthAudioProcessor::handleAsyncUpdate() {
+    applyImpulseResponseTrim();
 }
 
-void AvSynthAudioProcessor::updateAudioLevels(const juce::AudioBuffer<float>& buffer, int numSamples) {
-    if (buffer.getNumChannels() == 0 || numSamples == 0) {
-        currentLeftLevel.store(0.0f);
-        currentRightLevel.store(0.0f);
-        return;
-    }
+void AvSynthAudioProcessor::applyImpulseResponseTrim() {
+    impulseResponseLoader.setTrim(parameterRegistry.load<Parameters::ConvolutionHeadTrim>() / 1000.0f,
+                                  parameterRegistry.load<Parameters::ConvolutionTailLength>());
+}
 
-    // Process left channel
-    if (buffer.getNumChannels() >= 1) {
-        const float* leftData = buffer.getReadPointer(0);
+void AvSynthAudioProcessor::loadImpulseResponse(const juce::File& file) {
+    applyImpulseResponseTrim();
+    impulseResponseLoader.loadFile(file);
+    parameters.state.setProperty(IMPULSE_RESPONSE_PROPERTY, file.getFullPathName(), nullptr);
+}
 
-        // Create audio block for DSP processing
-        juce::dsp::AudioBlock<const float> leftBlock(&leftData, 1, numSamples);
+void AvSynthAudioProcessor::generateAudioSamples(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages,
+                                                 const ChainSettings& chainSettings, const float* vowelMorphValues) {
+    const auto totalNumOutputChannels = juce::jmin(getTotalNumOutputChannels(), buffer.getNumChannels());
+    const int numSamples = buffer.getNumSamples();
 
-        // Process through level filter
-        float leftLevel = leftLevelFilter.processSample(0, leftBlock.getSample(0, 0));
+    buffer.clear();
 
-        // Calculate RMS level for the block
-        float sum = 0.0f;
-        for (int i = 0; i < numSamples; ++i) {
-            sum += leftData[i] * leftData[i];
+    if (totalNumOutputChannels == 0) {
+        // Nothing to render into, but keep the voice state in sync with the notes
+        for (const auto metadata : midiMessages) {
+            handleMidiMessage(metadata.getMessage());
         }
-        leftLevel = std::sqrt(sum / numSamples);
-
-        currentLeftLevel.store(leftLevel);
+        updateVoiceDisplayState();
+        return;
     }
 
-    // Process right channel (or duplicate left if mono)
-    if (buffer.getNumChannels() >= 2) {
-        const float* rightData = buffer.getReadPointer(1);
-
-        // Calculate RMS level for the block
-        float sum = 0.0f;
-        for (int i = 0; i < numSamples; ++i) {
-            sum += rightData[i] * rightData[i];
-        }
-        float rightLevel = std::sqrt(sum / numSamples);
+    // Render up to each event, then apply it, so note timing is sample-accurate at any block size
+    float* voiceMix = buffer.getWritePointer(0);
+    int renderPosition = 0;
 
-        currentRightLevel.store(rightLevel);
-    } else {
-        // Mono signal - duplicate left channel level
-        currentRightLevel.store(currentLeftLevel.load());
+    for (const auto metadata : midiMessages) {
+        const int eventPosition = juce::jlimit(renderPosition, numSamples, metadata.samplePosition);
+        renderVoices(voiceMix, renderPosition, eventPosition - renderPosition, chainSettings, vowelMorphValues);
+        handleMidiMessage(metadata.getMessage());
+        renderPosition = eventPosition;
     }
-}
 
-//==============================================================================
-// Utility Methods
+    renderVoices(voiceMix, renderPosition, numSamples - renderPosition, chainSettings, vowelMorphValues);
 
-void AvSynthAudioProcessor::updateAngleDelta(float frequency) {
-    auto sampleRate = getSampleRate();
-    if (sampleRate <= 0.0) {
-        angleDelta = 0.0;
-        return;
+    // Copy the mono voice mix to all other output channels
+    for (int channel = 1; channel < totalNumOutputChannels; ++channel) {
+        buffer.copyFrom(channel, 0, buffer, 0, 0, numSamples);
     }
 
-    angleDelta = OscillatorUtils::calculateAngleDelta(frequency, sampleRate);
+    updateVoiceDisplayState();
 }
 
-bool AvSynthAudioProcessor::loadPreset(int presetIndex) {
-    const PresetData* preset = presetManager.getPreset(presetIndex);
-    if (!preset) {
-        return false;
+void AvSynthAudioProcessor::renderVoices(float* output, int startSample, int numSamples, const ChainSettings& chainSettings,
+                                         const float* vowelMorphValues) {
+    // Empty segment (events at the same position) or no active voice - nothing to add
+    if (numSamples <= 0 || !voicePool.isAnyVoiceActive()) {
+        return;
     }
 
-    // Set all parameters
-    auto* gainParam = parameters.getParameter(magic_enum::enum_name<Parameters::Gain>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(gainParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->gain));
+    if (vowelMorphValues == nullptr) {
+        voicePool.renderNextBlock(output + startSample, numSamples, chainSettings.oscType, chainSettings.VowelMorph);
+        return;
     }
 
-    auto* oscTypeParam = parameters.getParameter(magic_enum::enum_name<Parameters::OscType>().data());
-    if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(oscTypeParam)) {
-        choiceParam->setValueNotifyingHost(choiceParam->convertTo0to1(preset->oscType));
+    // Morph is ramping: update the formants at control rate, the vowel filters interpolate in between
+    const int endSample = startSample + numSamples;
+    for (int start = startSample; start < endSample; start += SmoothedParameter::controlBlockSize) {
+        const int length = juce::jmin(SmoothedParameter::controlBlockSize, endSample - start);
+        voicePool.renderNextBlock(output + start, length, chainSettings.oscType, vowelMorphValues[start + length - 1]);
     }
+}
 
-    auto* vowelParam = parameters.getParameter(magic_enum::enum_name<Parameters::VowelMorph>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(vowelParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->vowelMorph));
-    }
+void AvSynthAudioProcessor::updateVoiceDisplayState() {
+    numActiveVoices.store(voicePool.getNumActiveVoices());
 
-    auto* reverbParam = parameters.getParameter(magic_enum::enum_name<Parameters::ReverbAmount>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(reverbParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->reverbAmount));
+    const auto* voice = voicePool.getMostRecentVoice();
+    if (voice == nullptr || !voice->isActive()) {
+        currentEnvelopeValue.store(0.0f);
+        envelopeActive.store(false);
+        currentADSRState.store(static_cast<int>(ADSREnvelope::State::Idle));
+        return;
     }
 
-    auto* bitCrusherParam = parameters.getParameter(magic_enum::enum_name<Parameters::BitCrusherRate>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(bitCrusherParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->bitCrusherRate));
-    }
+    currentEnvelopeValue.store(voice->getLastEnvelopeValue());
+    envelopeActive.store(true);
+    currentADSRState.store(static_cast<int>(voice->getEnvelope().getState()));
+}
 
-    auto* attackParam = parameters.getParameter(magic_enum::enum_name<Parameters::Attack>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(attackParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->attack));
+void AvSynthAudioProcessor::updateVisualizationBuffer(const juce::AudioBuffer<float>& buffer, int numSamples,
+                                                      const ChainSettings& chainSettings) {
+    if (buffer.getNumChannels() == 0 || numSamples <= 0) {
+        return;
     }
 
-    auto* decayParam = parameters.getParameter(magic_enum::enum_name<Parameters::Decay>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(decayParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->decay));
+    // Keep a fixed-length history, so the view doesn't depend on the host block size
+    waveformHistory.writeBlock(buffer, numSamples);
+    waveformSamplesWritten += numSamples;
+
+    // Start the window at a cycle start of the newest voice, so a periodic tone stands still
+    int delay = 0;
+    juce::uint32 phase = 0;
+    juce::uint32 increment = 0;
+    if (voicePool.getMostRecentVoicePhase(phase, increment) && increment > 0) {
+        const double period = PhaseAccumulator::cycleLength / increment;
+        const double sinceCycleStart = static_cast<double>(phase) / increment;
+        const double cycles = juce::jmax(0.0, std::ceil((WAVEFORM_DISPLAY_SIZE - sinceCycleStart) / period));
+        const double windowStart = sinceCycleStart + cycles * period; // Samples before the end of the history
+
+        // Notes too low for a full cycle in the history simply scroll
+        if (windowStart <= WAVEFORM_HISTORY_SIZE) {
+            delay = juce::jlimit(0, WAVEFORM_HISTORY_SIZE - WAVEFORM_DISPLAY_SIZE,
+                                 juce::roundToInt(windowStart) - WAVEFORM_DISPLAY_SIZE);
+        }
     }
 
-    auto* sustainParam = parameters.getParameter(magic_enum::enum_name<Parameters::Sustain>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(sustainParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->sustain));
+    auto& snapshot = waveformSnapshots.getWriteBuffer();
+    waveformHistory.readLatest(0, snapshot.samples.data(), WAVEFORM_DISPLAY_SIZE, delay);
+
+    const auto range = juce::FloatVectorOperations::findMinAndMax(snapshot.samples.data(), WAVEFORM_DISPLAY_SIZE);
+    const auto* voice = voicePool.getMostRecentVoice();
+
+    WaveformShape shape;
+    shape.oscType = static_cast<int>(chainSettings.oscType);
+    shape.noteNumber = voice != nullptr ? voice->getNoteNumber() : -1;
+    shape.numActiveVoices = voicePool.getNumActiveVoices();
+    shape.vowelMorph = juce::roundToInt(chainSettings.VowelMorph * 256.0f);
+    shape.reverbAmount = juce::roundToInt(chainSettings.reverbAmount * 256.0f);
+    shape.bitCrusherRate = juce::roundToInt(chainSettings.bitCrusherRate * 256.0f);
+    shape.level = juce::roundToInt(juce::jmax(-range.getStart(), range.getEnd()) * 128.0f);
+
+    // An unchanged shape is not published at all, so a held note costs the UI nothing.
+    // Several voices don't repeat with the period of one of them, so they are always published.
+    if (shape.numActiveVoices <= 1 && shape == publishedWaveformShape) {
+        return;
     }
 
-    auto* releaseParam = parameters.getParameter(magic_enum::enum_name<Parameters::Release>().data());
-    if (auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(releaseParam)) {
-        floatParam->setValueNotifyingHost(floatParam->convertTo0to1(preset->release));
+    publishedWaveformShape = shape;
+    snapshot.numSamples = WAVEFORM_DISPLAY_SIZE;
+    snapshot.endPosition = waveformSamplesWritten - delay;
+    snapshot.version = ++waveformVersion;
+    waveformSnapshots.publish();
+}
+
+//==============================================================================
+// Utility Methods
+
+AvSynthAudioProcessor::UITelemetry AvSynthAudioProcessor::getUITelemetry() {
+    UITelemetry telemetry;
+    telemetry.envelopeValue = currentEnvelopeValue.load();
+    telemetry.envelopeActive = envelopeActive.load();
+    telemetry.adsrState = currentADSRState.load();
+    telemetry.numActiveVoices = numActiveVoices.load();
+    telemetry.left = levelMeter.getChannelLevels(0);
+    telemetry.right = levelMeter.getChannelLevels(1);
+    telemetry.loudness = levelMeter.getShortTermLoudness();
+    return telemetry;
+}
+
+bool AvSynthAudioProcessor::loadPreset(int presetIndex) {
+    const PresetData* preset = presetManager.getPreset(presetIndex);
+    if (!preset) {
+        return false;
     }
 
+    // Set all parameters
+    parameterRegistry.setValueNotifyingHost<Parameters::Gain>(preset->gain);
+    parameterRegistry.setValueNotifyingHost<Parameters::OscType>(static_cast<float>(preset->oscType));
+    parameterRegistry.setValueNotifyingHost<Parameters::VowelMorph>(preset->vowelMorph);
+    parameterRegistry.setValueNotifyingHost<Parameters::ReverbAmount>(preset->reverbAmount);
+    parameterRegistry.setValueNotifyingHost<Parameters::BitCrusherRate>(preset->bitCrusherRate);
+    parameterRegistry.setValueNotifyingHost<Parameters::Attack>(preset->attack);
+    parameterRegistry.setValueNotifyingHost<Parameters::Decay>(preset->decay);
+    parameterRegistry.setValueNotifyingHost<Parameters::Sustain>(preset->sustain);
+    parameterRegistry.setValueNotifyingHost<Parameters::Release>(preset->release);
+
     return true;
 }
 
@@ -463,6 +521,12 @@ void AvSynthAudioProcessor::setStateInformation(const void *data, int sizeInByte
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if (tree.isValid()) {
         parameters.replaceState(tree);
+
+        // Reload the impulse response of the restored state
+        const juce::File impulseResponseFile(parameters.state.getProperty(IMPULSE_RESPONSE_PROPERTY).toString());
+        if (impulseResponseFile.existsAsFile() && impulseResponseFile != impulseResponseLoader.getFile()) {
+            loadImpulseResponse(impulseResponseFile);
+        }
     }
 }
 
@@ -491,6 +555,22 @@ juce::AudioProcessorValueTreeState::ParameterLayout AvSynthAudioProcessor::creat
     layout.add(makeParameter<juce::AudioParameterFloat, Parameters::ReverbAmount>(
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
 
+    // Reverb engine, in the order of ReverbMode
+    layout.add(makeParameter<juce::AudioParameterChoice, Parameters::ReverbMode>(
+        juce::StringArray{magic_enum::enum_name<::ReverbMode::Classic>().data(),
+                          magic_enum::enum_name<::ReverbMode::Eco>().data(),
+                          magic_enum::enum_name<::ReverbMode::Normal>().data(),
+                          magic_enum::enum_name<::ReverbMode::High>().data(),
+                          magic_enum::enum_name<::ReverbMode::Convolution>().data()},
+        static_cast<int>(::ReverbMode::Classic)));
+
+    // Part of the impulse response used by the convolution (a shorter tail costs less CPU)
+    layout.add(makeParameter<juce::AudioParameterFloat, Parameters::ConvolutionHeadTrim>(
+        juce::NormalisableRange<float>(0.0f, ImpulseResponseLoader::maxHeadTrimSeconds * 1000.0f, 1.0f), 0.0f));
+
+    layout.add(makeParameter<juce::AudioParameterFloat, Parameters::ConvolutionTailLength>(
+        juce::NormalisableRange<float>(0.1f, ImpulseResponseLoader::maxTailLengthSeconds, 0.01f, 0.5f), 3.0f));
+
     layout.add(makeParameter<juce::AudioParameterFloat, Parameters::BitCrusherRate>(
         juce::NormalisableRange<float>(0.01f, 1.0f, 0.01f), 1.0f));
 
@@ -506,6 +586,22 @@ juce::AudioProcessorValueTreeState::ParameterLayout AvSynthAudioProcessor::creat
     layout.add(makeParameter<juce::AudioParameterFloat, Parameters::Release>(
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
 
+    // Envelope curve shapes, in the order of ADSREnvelope::CurveShape
+    const juce::StringArray curveShapes{
+        magic_enum::enum_name<ADSREnvelope::CurveShape::Linear>().data(),
+        magic_enum::enum_name<ADSREnvelope::CurveShape::Exponential>().data(),
+        magic_enum::enum_name<ADSREnvelope::CurveShape::Logarithmic>().data(),
+        magic_enum::enum_name<ADSREnvelope::CurveShape::AnalogRC>().data()};
+
+    layout.add(makeParameter<juce::AudioParameterChoice, Parameters::AttackCurve>(
+        curveShapes, static_cast<int>(ADSREnvelope::CurveShape::Linear)));
+
+    layout.add(makeParameter<juce::AudioParameterChoice, Parameters::DecayCurve>(
+        curveShapes, static_cast<int>(ADSREnvelope::CurveShape::Linear)));
+
+    layout.add(makeParameter<juce::AudioParameterChoice, Parameters::ReleaseCurve>(
+        curveShapes, static_cast<int>(ADSREnvelope::CurveShape::Linear)));
+
     return layout;
 }
 
@@ -5,7 +5,11 @@
 #include "Oscillator.hpp"
 #include "VowelFilter.hpp"
 #include "AudioEffects.hpp"
+#include "SynthVoice.hpp"
 #include "PresetManager.hpp"
+#include "ParameterRegistry.hpp"
+#include "LevelMeter.hpp"
+#include "ImpulseResponseLoader.hpp"
 #include "Utils.hpp"
 
 /**
@@ -19,7 +23,10 @@
  * This class handles all audio processing, parameter management, and MIDI input
  * for the AvSynth audio plugin. It integrates oscillators, effects, and preset management.
  */
-class AvSynthAudioProcessor final : public juce::AudioProcessor {
+class AvSynthAudioProcessor final : public juce::AudioProcessor,
+                                    private juce::Timer,
+                                    private juce::AudioProcessorValueTreeState::Listener,
+                                    private juce::AsyncUpdater {
     friend class AvSynthAudioProcessorEditor;
 
 public:
@@ -37,6 +44,12 @@ public:
         Decay,          ///< ADSR decay time
         Sustain,        ///< ADSR sustain level
         Release,        ///< ADSR release time
+        AttackCurve,    ///< ADSR attack curve shape
+        DecayCurve,     ///< ADSR decay curve shape
+        ReleaseCurve,   ///< ADSR release curve shape
+        ReverbMode,     ///< Reverb engine selection
+        ConvolutionHeadTrim,   ///< Time cut off the start of the impulse response (ms)
+        ConvolutionTailLength, ///< Length of the impulse response that is used (s)
         NumParameters   ///< Total number of parameters
     };
 
@@ -49,18 +62,22 @@ public:
         OscType oscType = OscType::Sine;    ///< Selected oscillator type
         float VowelMorph = 0.0f;           ///< Vowel morphing value (0.0 = "A", 1.0 = "U")
         float reverbAmount = 0.0f;         ///< Reverb amount (0.0 to 1.0)
+        ::ReverbMode reverbMode = ::ReverbMode::Classic; ///< Reverb engine
         float bitCrusherRate = 0.01f;      ///< Bit crusher rate (0.01 to 1.0)
         float attack = 0.1f;               ///< ADSR attack (0.0 to 1.0)
         float decay = 0.3f;                ///< ADSR decay (0.0 to 1.0)
         float sustain = 0.7f;              ///< ADSR sustain (0.0 to 1.0)
         float release = 0.5f;              ///< ADSR release (0.0 to 1.0)
+        ADSREnvelope::CurveShape attackCurve = ADSREnvelope::CurveShape::Linear;  ///< ADSR attack curve
+        ADSREnvelope::CurveShape decayCurve = ADSREnvelope::CurveShape::Linear;   ///< ADSR decay curve
+        ADSREnvelope::CurveShape releaseCurve = ADSREnvelope::CurveShape::Linear; ///< ADSR release curve
 
         /**
          * @brief Create ChainSettings from current parameter values
-         * @param parameters Reference to the parameter tree state
+         * @param registry Cached parameter handles
          * @return ChainSettings structure with current values
          */
-        static forcedinline ChainSettings Get(const juce::AudioProcessorValueTreeState &parameters);
+        static forcedinline ChainSettings Get(const ParameterRegistry<Parameters> &registry);
     };
 
 public:
@@ -207,28 +224,47 @@ public:
     // Public utility methods
 
     /**
-     * @brief Update oscillator angle delta for given frequency
-     * @param frequency Frequency in Hz
+     * @brief Everything the editor displays from the audio thread, read once per UI frame
      */
-    void updateAngleDelta(float frequency);
+    struct UITelemetry {
+        float envelopeValue = 0.0f;                  ///< Envelope value of the most recent voice
+        bool envelopeActive = false;                 ///< Whether that envelope is active
+        int adsrState = 0;                           ///< ADSR state of that voice
+        int numActiveVoices = 0;                     ///< Number of sounding voices
+        LevelMeter::ChannelLevels left;              ///< Output levels of the left channel
+        LevelMeter::ChannelLevels right;             ///< Output levels of the right channel
+        float loudness = LevelMeter::minLoudness;    ///< Short-term loudness in LUFS
+    };
 
     /**
-     * @brief Get current envelope value for UI display
+     * @brief Read all UI telemetry at once (message thread only, restarts the meter peaks)
+     * @return Current telemetry
+     */
+    UITelemetry getUITelemetry();
+
+    /**
+     * @brief Get current envelope value of the most recent voice for UI display
      * @return Current envelope value (0.0 to 1.0)
      */
     float getCurrentEnvelopeValue() const { return currentEnvelopeValue.load(); }
 
     /**
-     * @brief Check if envelope is currently active
+     * @brief Check if the envelope of the most recent voice is currently active
      * @return True if envelope is active
      */
-    bool isEnvelopeActive() const { return envelope.isActive(); }
+    bool isEnvelopeActive() const { return envelopeActive.load(); }
 
     /**
-     * @brief Get current ADSR state for UI display
+     * @brief Get current ADSR state of the most recent voice for UI display
      * @return Current ADSR state (0=idle, 1=attack, 2=decay, 3=sustain, 4=release)
      */
-    int getADSRState() const { return static_cast<int>(envelope.getState()); }
+    int getADSRState() const { return currentADSRState.load(); }
+
+    /**
+     * @brief Get the number of voices currently producing sound
+     * @return Number of active voices
+     */
+    int getNumActiveVoices() const { return numActiveVoices.load(); }
 
     /**
      * @brief Get reference to preset manager
@@ -250,14 +286,19 @@ public:
     bool loadPreset(int presetIndex);
 
     /**
-     * @brief Get current audio levels for VU meter (thread-safe)
-     * @param leftLevel Reference to store left channel level
-     * @param rightLevel Reference to store right channel level
+     * @brief Load an impulse response file for the convolution reverb (message thread only)
+     *
+     * The file is read and prepared in the background; the current impulse response stays
+     * active until the new one is ready. The file is stored with the plugin state.
+     * @param file Audio file with the impulse response
+     */
+    void loadImpulseResponse(const juce::File& file);
+
+    /**
+     * @brief Get the file of the current impulse response
+     * @return Impulse response file, or an empty File if none was loaded
      */
-    void getCurrentAudioLevels(float& leftLevel, float& rightLevel) const {
-        leftLevel = currentLeftLevel.load();
-        rightLevel = currentRightLevel.load();
-    }
+    const juce::File& getImpulseResponseFile() const { return impulseResponseLoader.getFile(); }
 
 private:
     /**
@@ -267,68 +308,153 @@ private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     /**
-     * @brief Process MIDI messages and update synthesizer state
-     * @param midiMessages MIDI buffer to process
-     * @param numSamples Number of samples in current block
+     * @brief Apply a single MIDI message to the synthesizer state
+     * @param msg MIDI message to handle
+     */
+    void handleMidiMessage(const juce::MidiMessage& msg);
+
+    /**
+     * @brief Timer callback that applies queued note frequencies to the Frequency parameter
+     *
+     * Runs on the message thread, so the host notification and the parameter listeners
+     * never block the audio thread.
+     */
+    void timerCallback() override;
+
+    /**
+     * @brief Schedule passing changed impulse response trim parameters to the loader
+     *
+     * Host automation calls this on the audio thread, so the loader is updated
+     * asynchronously on the message thread.
+     * @param parameterID ID of the changed parameter
+     * @param newValue New parameter value
+     */
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    /**
+     * @brief Pass the impulse response trim parameters to the loader (message thread)
      */
-    void processMidiMessages(const juce::MidiBuffer& midiMessages, int numSamples);
+    void handleAsyncUpdate() override;
 
     /**
-     * @brief Generate audio samples using current oscillator and settings
+     * @brief Set the loader's head trim and tail length from the parameters (message thread only)
+     *
+     * The loader re-cuts the impulse response in the background only if a value changed.
+     */
+    void applyImpulseResponseTrim();
+
+    /**
+     * @brief Generate audio samples by summing all active voices
+     *
+     * The block is rendered in segments between MIDI events, and each event is applied
+     * at its sample position.
      * @param buffer Audio buffer to fill
-     * @param numSamples Number of samples to generate
+     * @param midiMessages MIDI events of this block
      * @param chainSettings Current parameter settings
+     * @param vowelMorphValues Smoothed vowel morph per sample, or nullptr if it is constant for the block
      */
-    void generateAudioSamples(juce::AudioBuffer<float>& buffer, int numSamples, const ChainSettings& chainSettings);
+    void generateAudioSamples(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages,
+                              const ChainSettings& chainSettings, const float* vowelMorphValues);
 
     /**
-     * @brief Update the circular buffer for waveform visualization
-     * @param buffer Source audio buffer
-     * @param numSamples Number of samples to copy
+     * @brief Render all active voices for one segment of the block
+     * @param output Mono voice mix to add to
+     * @param startSample First sample of the segment
+     * @param numSamples Number of samples in the segment
+     * @param chainSettings Current parameter settings
+     * @param vowelMorphValues Smoothed vowel morph per sample of the whole block, or nullptr if it is constant
      */
-    void updateVisualizationBuffer(const juce::AudioBuffer<float>& buffer, int numSamples);
+    void renderVoices(float* output, int startSample, int numSamples, const ChainSettings& chainSettings,
+                      const float* vowelMorphValues);
 
     /**
-     * @brief Update audio levels for VU meter display
-     * @param buffer Audio buffer to analyze
-     * @param numSamples Number of samples to analyze
+     * @brief Publish the state of the most recent voice for the UI
      */
-    void updateAudioLevels(const juce::AudioBuffer<float>& buffer, int numSamples);
+    void updateVoiceDisplayState();
+
+    /**
+     * @brief Append the output to the waveform history and publish a phase-aligned window if its shape changed
+     * @param buffer Source audio buffer
+     * @param numSamples Number of samples to copy
+     * @param chainSettings Settings used to render the block
+     */
+    void updateVisualizationBuffer(const juce::AudioBuffer<float>& buffer, int numSamples,
+                                   const ChainSettings& chainSettings);
+
 
 public:
     //==============================================================================
     // Public member variables (for editor access)
 
     juce::AudioProcessorValueTreeState parameters; ///< Parameter tree state
+    ParameterRegistry<Parameters> parameterRegistry; ///< Cached parameter handles (built from parameters)
     juce::MidiKeyboardState keyboardState;         ///< MIDI keyboard state
-    CircularAudioBuffer circularBuffer;            ///< Buffer for waveform visualization
-    int bufferWritePos{0};             ///< Write position for circular buffer
+    TripleBuffer<WaveformSnapshot> waveformSnapshots; ///< Latest output block for waveform visualization
 
 private:
     //==============================================================================
     // Private member variables
 
     // Core synthesis components
-    VowelFilter vowelFilter;                        ///< Vowel morphing filter
     EffectsChain effectsChain;                      ///< Audio effects chain
-    ADSREnvelope envelope;                          ///< ADSR envelope generator
+    WavetableBank wavetableBank;                    ///< Band-limited oscillator tables
+    VoicePool voicePool;                            ///< Polyphonic voice pool
     PresetManager presetManager;                    ///< Preset management system
 
     // Synthesis state
     ChainSettings previousChainSettings;            ///< Previous parameter settings for change detection
-    double currentAngle = 0.0;                      ///< Current oscillator phase angle
-    double angleDelta = 0.0;                        ///< Phase increment per sample
-    bool noteIsActive = false;                      ///< Current note activity state
-    float currentNoteFrequency = 0.0f;              ///< Current note frequency in Hz
+
+    // Waveform visualization
+    /**
+     * @brief Everything that changes the look of the waveform window (quantized to what the view can show)
+     */
+    struct WaveformShape {
+        int oscType = -1;               ///< Oscillator type
+        int noteNumber = -1;            ///< Note of the most recent voice
+        int numActiveVoices = 0;        ///< Sounding voices
+        int vowelMorph = 0;             ///< Vowel morph in 1/256 steps
+        int reverbAmount = 0;           ///< Reverb amount in 1/256 steps
+        int bitCrusherRate = 0;         ///< Bit crusher rate in 1/256 steps
+        int level = 0;                  ///< Peak of the window in 1/128 steps (follows envelope and gain)
+
+        bool operator==(const WaveformShape&) const = default;
+    };
+
+    static constexpr int WAVEFORM_DISPLAY_SIZE = 1024; ///< Samples shown by the waveform view
+    static constexpr int WAVEFORM_HISTORY_SIZE = 2 * WAVEFORM_DISPLAY_SIZE; ///< Room to align the window to a cycle
+    static_assert(WAVEFORM_DISPLAY_SIZE <= WaveformSnapshot::capacity, "Window must fit into a snapshot");
+    CircularAudioBuffer waveformHistory{1, WAVEFORM_HISTORY_SIZE}; ///< Newest output samples (audio thread only)
+    juce::int64 waveformSamplesWritten = 0; ///< Total samples written to the history (never decreases)
+    juce::uint32 waveformVersion = 0;       ///< Version of the last published window
+    WaveformShape publishedWaveformShape;   ///< Shape of the last published window
+
+    // Parameter smoothing
+    static constexpr double SMOOTHING_TIME_SECONDS = 0.05; ///< Ramp time of the continuous parameters
+    SmoothedParameter gainSmoother;                 ///< Per-sample output gain
+    SmoothedParameter vowelMorphSmoother;           ///< Per-sample vowel morph
+    SmoothedParameter reverbAmountSmoother;         ///< Per-sample reverb amount
+    SmoothedParameter bitCrusherRateSmoother;       ///< Per-sample bit crusher rate
+
+    // Audio thread to message thread communication
+    static constexpr int NOTE_QUEUE_SIZE = 256;     ///< Note-ons buffered between two timer callbacks
+    static constexpr int NOTE_QUEUE_RATE_HZ = 30;   ///< Rate at which the note queue is drained
+    SPSCQueue<float, NOTE_QUEUE_SIZE> noteFrequencyQueue; ///< Note frequencies in Hz, pushed on note-on
 
     // Thread-safe UI communication
     std::atomic<float> currentEnvelopeValue{0.0f};  ///< Current envelope value for UI
-    std::atomic<float> currentLeftLevel{0.0f};      ///< Current left channel level for VU meter
-    std::atomic<float> currentRightLevel{0.0f};     ///< Current right channel level for VU meter
-
-    // Level calculation for VU meter
-    juce::dsp::BallisticsFilter<float> leftLevelFilter;  ///< Left channel level filter
-    juce::dsp::BallisticsFilter<float> rightLevelFilter; ///< Right channel level filter
+    std::atomic<bool> envelopeActive{false};        ///< Envelope activity of the most recent voice for UI
+    std::atomic<int> currentADSRState{0};           ///< ADSR state of the most recent voice for UI
+    std::atomic<int> numActiveVoices{0};            ///< Number of sounding voices for UI
+
+    // Output metering for the VU meter
+    LevelMeter levelMeter;                          ///< Peak, RMS, true-peak and loudness of the output
+
+    // Convolution reverb
+    static constexpr const char* IMPULSE_RESPONSE_PROPERTY = "ImpulseResponseFile"; ///< State property with the IR path
+    /// Parameters that re-cut the impulse response when they change
+    static constexpr std::array<Parameters, 2> IMPULSE_RESPONSE_TRIM_PARAMETERS{Parameters::ConvolutionHeadTrim,
+                                                                               Parameters::ConvolutionTailLength};
+    ImpulseResponseLoader impulseResponseLoader;    ///< Background IR loading (declared after effectsChain, stops first)
 
     // Utility objects
     juce::Random random;                            ///< Random number generator
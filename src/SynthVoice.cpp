@@ -0,0 +1,221 @@
+#include "SynthVoice.hpp"
+
+// SynthVoice Implementation
+void SynthVoice::prepare(double sampleRate) {
+    envelope.setSampleRate(sampleRate);
+    reset();
+}
+
+void SynthVoice::startNote(int midiNoteNumber, juce::uint32 noteAge) {
+    noteNumber = midiNoteNumber;
+    age = noteAge;
+    keyDown = true;
+
+    // A silent voice starts with cleared resonators; a sounding one keeps ringing through the retrigger
+    if (!envelope.isActive()) {
+        vowelFilter.reset();
+    }
+
+    envelope.noteOn();
+}
+
+void SynthVoice::stopNote() {
+    keyDown = false;
+    envelope.noteOff();
+}
+
+void SynthVoice::renderNextBlock(float* output, float* oscillatorSamples, int numSamples,
+                                 const FormantCoefficients& formants) {
+    // Vowel formants on the band-limited oscillator signal
+    vowelFilter.setCoefficients(formants);
+    vowelFilter.processBlock(oscillatorSamples, numSamples);
+
+    // Envelope rendered in blocks and applied with one vector multiply-add per chunk
+    constexpr int envelopeChunkSize = 64;
+    float gains[envelopeChunkSize];
+
+    for (int start = 0; start < numSamples && envelope.isActive(); start += envelopeChunkSize) {
+        const int count = juce::jmin(envelopeChunkSize, numSamples - start);
+        envelope.renderBlock(gains, count);
+        juce::FloatVectorOperations::addWithMultiply(output + start, oscillatorSamples + start, gains, count);
+    }
+
+    lastEnvelopeValue = envelope.getCurrentValue();
+
+    // Voice has finished its release phase
+    if (!envelope.isActive()) {
+        keyDown = false;
+    }
+}
+
+void SynthVoice::reset() {
+    envelope.reset();
+    vowelFilter.reset();
+    keyDown = false;
+    lastEnvelopeValue = 0.0f;
+}
+
+// VoicePool Implementation
+void VoicePool::prepare(double sampleRate, int maximumBlockSize, const WavetableBank& wavetableBank, int numVoices) {
+    voices.resize(static_cast<size_t>(juce::jlimit(1, maxVoices, numVoices)));
+
+    for (auto& voice : voices) {
+        voice.prepare(sampleRate);
+        voice.setEnvelopeParameters(envelopeParameters);
+    }
+
+    oscillatorBank.prepare(wavetableBank, sampleRate);
+    oscillatorBuffer.setSize(maxVoices, juce::jmax(1, maximumBlockSize));
+
+    currentSampleRate = sampleRate;
+    formantMorph = -1.0f; // Force a coefficient update on the next block
+
+    mostRecentVoice = -1;
+}
+
+void VoicePool::noteOn(int midiNoteNumber, float frequency) {
+    if (voices.empty()) {
+        return;
+    }
+
+    const int index = findVoiceForNote(midiNoteNumber);
+    auto& voice = voices[static_cast<size_t>(index)];
+
+    // Restart the phase only if the voice was silent, so retriggering a sounding voice doesn't click
+    oscillatorBank.startVoice(index, frequency, !voice.isActive());
+    voice.startNote(midiNoteNumber, ++noteCounter);
+    mostRecentVoice = index;
+}
+
+void VoicePool::noteOff(int midiNoteNumber) {
+    for (auto& voice : voices) {
+        if (voice.isKeyDown() && voice.getNoteNumber() == midiNoteNumber) {
+            voice.stopNote();
+        }
+    }
+}
+
+void VoicePool::allNotesOff() {
+    for (auto& voice : voices) {
+        if (voice.isKeyDown()) {
+            voice.stopNote();
+        }
+    }
+}
+
+void VoicePool::setEnvelopeParameters(const ADSREnvelope::Parameters& params) {
+    envelopeParameters = params;
+
+    for (auto& voice : voices) {
+        voice.setEnvelopeParameters(params);
+    }
+}
+
+void VoicePool::renderNextBlock(float* output, int numSamples, OscType oscType, float vowelMorph) {
+    // Oscillator type can only change between blocks
+    oscillatorBank.setOscType(oscType);
+
+    const juce::uint32 activeVoiceMask = getActiveVoiceMask();
+    if (activeVoiceMask == 0) {
+        return;
+    }
+
+    // Formant coefficients are shared by all voices and only recomputed when the morph changes
+    if (!juce::exactlyEqual(vowelMorph, formantMorph)) {
+        formantMorph = vowelMorph;
+        formantCoefficients = VowelFilter::makeCoefficients(vowelMorph, currentSampleRate);
+    }
+
+    // Render in chunks that fit the per-voice oscillator rows
+    for (int start = 0; start < numSamples;) {
+        const int chunk = juce::jmin(numSamples - start, oscillatorBuffer.getNumSamples());
+        oscillatorBank.renderBlock(oscillatorBuffer.getArrayOfWritePointers(), activeVoiceMask, chunk);
+
+        for (int i = 0; i < static_cast<int>(voices.size()); ++i) {
+            if ((activeVoiceMask >> i) & 1u) {
+                voices[static_cast<size_t>(i)].renderNextBlock(output + start, oscillatorBuffer.getWritePointer(i),
+                                                               chunk, formantCoefficients);
+            }
+        }
+
+        start += chunk;
+    }
+}
+
+bool VoicePool::isAnyVoiceActive() const {
+    return std::any_of(voices.begin(), voices.end(), [](const SynthVoice& voice) { return voice.isActive(); });
+}
+
+int VoicePool::getNumActiveVoices() const {
+    return static_cast<int>(
+        std::count_if(voices.begin(), voices.end(), [](const SynthVoice& voice) { return voice.isActive(); }));
+}
+
+const SynthVoice* VoicePool::getMostRecentVoice() const {
+    if (mostRecentVoice < 0 || mostRecentVoice >= static_cast<int>(voices.size())) {
+        return nullptr;
+    }
+    return &voices[static_cast<size_t>(mostRecentVoice)];
+}
+
+bool VoicePool::getMostRecentVoicePhase(juce::uint32& phase, juce::uint32& increment) const {
+    const auto* voice = getMostRecentVoice();
+    if (voice == nullptr || !voice->isActive()) {
+        return false;
+    }
+
+    phase = oscillatorBank.getPhase(mostRecentVoice);
+    increment = oscillatorBank.getPhaseIncrement(mostRecentVoice);
+    return true;
+}
+
+void VoicePool::reset() {
+    for (auto& voice : voices) {
+        voice.reset();
+    }
+    oscillatorBank.reset();
+}
+
+juce::uint32 VoicePool::getActiveVoiceMask() const {
+    juce::uint32 mask = 0;
+    for (size_t i = 0; i < voices.size(); ++i) {
+        if (voices[i].isActive()) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+int VoicePool::findVoiceForNote(int midiNoteNumber) const {
+    int freeVoice = -1;
+    int oldestReleased = -1;
+    int oldestHeld = -1;
+
+    for (int i = 0; i < static_cast<int>(voices.size()); ++i) {
+        const auto& voice = voices[static_cast<size_t>(i)];
+
+        // Retrigger a voice that is still sounding the same note
+        if (voice.isActive() && voice.getNoteNumber() == midiNoteNumber) {
+            return i;
+        }
+
+        if (!voice.isActive()) {
+            if (freeVoice < 0) {
+                freeVoice = i;
+            }
+        } else if (!voice.isKeyDown()) {
+            if (oldestReleased < 0 || voice.getAge() < voices[static_cast<size_t>(oldestReleased)].getAge()) {
+                oldestReleased = i;
+            }
+        } else if (oldestHeld < 0 || voice.getAge() < voices[static_cast<size_t>(oldestHeld)].getAge()) {
+            oldestHeld = i;
+        }
+    }
+
+    if (freeVoice >= 0) {
+        return freeVoice;
+    }
+
+    // All voices busy: steal the oldest released voice, otherwise the oldest held one
+    return oldestReleased >= 0 ? oldestReleased : oldestHeld;
+}
@@ -0,0 +1,235 @@
+#pragma once
+#include "JuceHeader.h"
+#include "Oscillator.hpp"
+#include "Wavetable.hpp"
+#include "OscillatorBank.hpp"
+#include "VowelFilter.hpp"
+#include "AudioEffects.hpp"
+#include <vector>
+
+/**
+ * @file SynthVoice.hpp
+ * @brief Polyphonic voice and fixed-capacity voice pool for the AvSynth audio plugin
+ */
+
+/**
+ * @brief A single synthesizer voice
+ *
+ * Each voice owns its own ADSR envelope and vowel filter state, so several notes can
+ * sound at the same time without interfering with each other. The oscillators of all
+ * voices live in the OscillatorBank of the VoicePool so they can be rendered with SIMD.
+ */
+class SynthVoice {
+public:
+    /**
+     * @brief Constructor
+     */
+    SynthVoice() = default;
+
+    /**
+     * @brief Destructor
+     */
+    ~SynthVoice() = default;
+
+    /**
+     * @brief Prepare the voice for playback
+     * @param sampleRate Sample rate in Hz
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Start playing a note on this voice
+     * @param midiNoteNumber MIDI note number (0-127)
+     * @param noteAge Monotonic counter value used for voice stealing
+     */
+    void startNote(int midiNoteNumber, juce::uint32 noteAge);
+
+    /**
+     * @brief Release the currently playing note (enters release phase)
+     */
+    void stopNote();
+
+    /**
+     * @brief Set the envelope parameters of this voice
+     * @param params ADSR parameters
+     */
+    void setEnvelopeParameters(const ADSREnvelope::Parameters& params) { envelope.setParameters(params); }
+
+    /**
+     * @brief Filter and envelope the rendered oscillator signal and add it to the output
+     * @param output Mono output buffer the voice is summed into
+     * @param oscillatorSamples Oscillator signal of this voice from the OscillatorBank (filtered in place)
+     * @param numSamples Number of samples to render
+     * @param formants Vowel formant coefficients to reach by the end of the block
+     */
+    void renderNextBlock(float* output, float* oscillatorSamples, int numSamples, const FormantCoefficients& formants);
+
+    /**
+     * @brief Check if the voice is producing sound
+     * @return True if the envelope of this voice is active
+     */
+    bool isActive() const { return envelope.isActive(); }
+
+    /**
+     * @brief Check if the key of this voice is still held
+     * @return True if the note has not been released yet
+     */
+    bool isKeyDown() const { return keyDown; }
+
+    /**
+     * @brief Get the MIDI note number played by this voice
+     * @return MIDI note number, or -1 if no note was started
+     */
+    int getNoteNumber() const { return noteNumber; }
+
+    /**
+     * @brief Get the age stamp of the note played by this voice
+     * @return Age stamp (higher values are newer notes)
+     */
+    juce::uint32 getAge() const { return age; }
+
+    /**
+     * @brief Get the last rendered envelope value
+     * @return Envelope value (0.0 to 1.0)
+     */
+    float getLastEnvelopeValue() const { return lastEnvelopeValue; }
+
+    /**
+     * @brief Get the envelope of this voice
+     * @return Const reference to the envelope
+     */
+    const ADSREnvelope& getEnvelope() const { return envelope; }
+
+    /**
+     * @brief Reset the voice to idle state
+     */
+    void reset();
+
+private:
+    ADSREnvelope envelope;              ///< Per-voice ADSR envelope
+    VowelFilter vowelFilter;            ///< Per-voice vowel filter
+    int noteNumber = -1;                ///< MIDI note number
+    bool keyDown = false;               ///< Whether the note is still held
+    juce::uint32 age = 0;               ///< Age stamp for voice stealing
+    float lastEnvelopeValue = 0.0f;     ///< Last rendered envelope value
+};
+
+/**
+ * @brief Fixed-capacity pool of synthesizer voices
+ *
+ * All voices are allocated in prepare(), so note handling and rendering never
+ * allocate memory on the audio thread. When every voice is busy the oldest
+ * released voice (or, failing that, the oldest held voice) is stolen.
+ */
+class VoicePool {
+public:
+    static constexpr int maxVoices = OscillatorBank::maxVoices; ///< Maximum number of simultaneous voices
+
+    /**
+     * @brief Constructor
+     */
+    VoicePool() = default;
+
+    /**
+     * @brief Destructor
+     */
+    ~VoicePool() = default;
+
+    /**
+     * @brief Allocate and prepare all voices (call from prepareToPlay only)
+     * @param sampleRate Sample rate in Hz
+     * @param maximumBlockSize Largest block size passed to renderNextBlock() without splitting
+     * @param wavetableBank Band-limited tables shared by all voices (must be prepared)
+     * @param numVoices Number of voices to allocate (1 to maxVoices)
+     */
+    void prepare(double sampleRate, int maximumBlockSize, const WavetableBank& wavetableBank,
+                 int numVoices = maxVoices);
+
+    /**
+     * @brief Start a note on a free (or stolen) voice
+     * @param midiNoteNumber MIDI note number (0-127)
+     * @param frequency Note frequency in Hz
+     */
+    void noteOn(int midiNoteNumber, float frequency);
+
+    /**
+     * @brief Release all voices playing the given note
+     * @param midiNoteNumber MIDI note number (0-127)
+     */
+    void noteOff(int midiNoteNumber);
+
+    /**
+     * @brief Release all playing voices
+     */
+    void allNotesOff();
+
+    /**
+     * @brief Set the envelope parameters of all voices
+     * @param params ADSR parameters
+     */
+    void setEnvelopeParameters(const ADSREnvelope::Parameters& params);
+
+    /**
+     * @brief Render all active voices and sum them into the output
+     * @param output Mono output buffer (must be cleared by the caller)
+     * @param numSamples Number of samples to render
+     * @param oscType Oscillator type
+     * @param vowelMorph Vowel morphing value (0.0 to 1.0)
+     */
+    void renderNextBlock(float* output, int numSamples, OscType oscType, float vowelMorph);
+
+    /**
+     * @brief Check if any voice is producing sound
+     * @return True if at least one voice is active
+     */
+    bool isAnyVoiceActive() const;
+
+    /**
+     * @brief Get the number of voices currently producing sound
+     * @return Number of active voices
+     */
+    int getNumActiveVoices() const;
+
+    /**
+     * @brief Get the most recently triggered voice (used for UI display)
+     * @return Pointer to the voice, or nullptr if no note was played yet
+     */
+    const SynthVoice* getMostRecentVoice() const;
+
+    /**
+     * @brief Get the oscillator phase of the most recently triggered voice (used for UI display)
+     * @param phase Receives the fixed-point phase of the next sample to render
+     * @param increment Receives the fixed-point phase increment per sample
+     * @return True if that voice is active
+     */
+    bool getMostRecentVoicePhase(juce::uint32& phase, juce::uint32& increment) const;
+
+    /**
+     * @brief Reset all voices to idle state
+     */
+    void reset();
+
+private:
+    /**
+     * @brief Find the voice to use for a new note
+     * @param midiNoteNumber MIDI note number of the new note
+     * @return Index of the voice to (re)trigger
+     */
+    int findVoiceForNote(int midiNoteNumber) const;
+
+    /**
+     * @brief Build the bit mask of voices that are producing sound
+     * @return Bit n set if voice n is active
+     */
+    juce::uint32 getActiveVoiceMask() const;
+
+    std::vector<SynthVoice> voices;              ///< Voice storage (sized in prepare)
+    OscillatorBank oscillatorBank;               ///< Oscillators of all voices (SIMD kernel)
+    juce::AudioBuffer<float> oscillatorBuffer;   ///< One oscillator row per voice (sized in prepare)
+    FormantCoefficients formantCoefficients;     ///< Vowel resonator coefficients shared by all voices
+    float formantMorph = -1.0f;                  ///< Morph value the coefficients were computed for
+    double currentSampleRate = 44100.0;          ///< Sample rate in Hz
+    ADSREnvelope::Parameters envelopeParameters; ///< Current envelope parameters
+    juce::uint32 noteCounter = 0;                ///< Monotonic note counter for voice ages
+    int mostRecentVoice = -1;                    ///< Index of the most recently triggered voice
+};
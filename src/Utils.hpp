@@ -1,7 +1,13 @@
 #pragma once
 #include <type_traits>
+#include <array>
 #include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <limits>
 #include "JuceHeader.h"
+#include "FastMath.hpp"
 
 /**
  * @file Utils.hpp
@@ -28,9 +34,10 @@ public:
      * @param steps Number of steps to reach the target
      */
     void reset(T start, T end, int steps) {
-        current = start;
+        current = (steps > 0) ? start : end;
+        target = end;
         increment = (steps > 0) ? (end - start) / static_cast<std::common_type_t<T, float>>(steps) : T{};
-        remainingSteps = steps;
+        remainingSteps = juce::jmax(0, steps);
     }
 
     /**
@@ -51,12 +58,485 @@ public:
         return value;
     }
 
+    /**
+     * @brief Write the next values of the ramp to a buffer
+     *
+     * Produces the same sequence as repeated getNext() calls, but every value is computed
+     * from the block start, so the loop has no carried dependency and is vectorized. The
+     * samples after the end of the ramp are filled with the target value.
+     * @param output Destination buffer
+     * @param numSamples Number of values to write
+     */
+    void fillBlock(T* output, int numSamples) {
+        using Scalar = std::common_type_t<T, float>;
+        const int rampSamples = juce::jmin(numSamples, remainingSteps);
+        const T start = current;
+
+        for (int i = 0; i < rampSamples; ++i) {
+            output[i] = start + increment * static_cast<Scalar>(i);
+        }
+
+        remainingSteps -= rampSamples;
+        current = (remainingSteps > 0) ? start + increment * static_cast<Scalar>(rampSamples) : target;
+        std::fill(output + rampSamples, output + juce::jmax(rampSamples, numSamples), current);
+    }
+
+    /**
+     * @brief Check if the ramp has reached its target
+     * @return True if no steps are left
+     */
+    bool isSettled() const { return remainingSteps <= 0; }
+
+    /**
+     * @brief Get the value the next call to getNext() returns
+     * @return Current value
+     */
+    T getCurrent() const { return current; }
+
+    /**
+     * @brief Get the end value of the ramp
+     * @return Target value
+     */
+    T getTarget() const { return target; }
+
 private:
     T current{};           ///< Current value in the ramp
+    T target{};            ///< End value of the ramp
     T increment{};         ///< Increment per step
     int remainingSteps = 0; ///< Remaining steps in the ramp
 };
 
+/**
+ * @brief Per-sample smoothing of one continuous parameter, built on LinearRamp
+ *
+ * A new ramp towards the parameter value starts whenever the value changes. While the
+ * ramp runs, getNextBlock() renders a whole block of smoothed values at once; when the
+ * parameter is settled it does no work and returns nullptr, so callers can take their
+ * constant-value path.
+ */
+class SmoothedParameter {
+public:
+    static constexpr int controlBlockSize = 32; ///< Update interval for consumers that can only change at control rate
+
+    /**
+     * @brief Prepare the smoother (allocates, call from prepareToPlay only)
+     * @param sampleRate Sample rate in Hz
+     * @param maximumBlockSize Largest block passed to getNextBlock()
+     * @param rampLengthSeconds Time to reach a new value
+     * @param initialValue Value to start from
+     */
+    void prepare(double sampleRate, int maximumBlockSize, double rampLengthSeconds, float initialValue) {
+        rampLength = juce::jmax(1, juce::roundToInt(sampleRate * rampLengthSeconds));
+        values.assign(static_cast<size_t>(juce::jmax(1, maximumBlockSize)), initialValue);
+        ramp.reset(initialValue, initialValue, 0);
+    }
+
+    /**
+     * @brief Set the value to ramp to (starts a new ramp from the current value if it changed)
+     * @param newTarget New parameter value
+     */
+    void setTargetValue(float newTarget) {
+        if (!juce::exactlyEqual(newTarget, ramp.getTarget())) {
+            ramp.reset(ramp.getCurrent(), newTarget, rampLength);
+        }
+    }
+
+    /**
+     * @brief Get the value the parameter is ramping to
+     * @return Target value
+     */
+    float getTargetValue() const { return ramp.getTarget(); }
+
+    /**
+     * @brief Check if the parameter is still ramping
+     * @return True if the next block needs per-sample values
+     */
+    bool isSmoothing() const { return !ramp.isSettled(); }
+
+    /**
+     * @brief Render the smoothed values of the next block
+     * @param numSamples Block size (at most the maximumBlockSize given to prepare())
+     * @return Pointer to numSamples values, or nullptr if the value is getTargetValue() for the whole block
+     */
+    const float* getNextBlock(int numSamples) {
+        if (ramp.isSettled()) {
+            return nullptr;
+        }
+
+        if (numSamples > static_cast<int>(values.size())) {
+            // Larger than announced in prepareToPlay: jump instead of allocating on the audio thread
+            jassertfalse;
+            ramp.reset(ramp.getTarget(), ramp.getTarget(), 0);
+            return nullptr;
+        }
+
+        ramp.fillBlock(values.data(), numSamples);
+        return values.data();
+    }
+
+private:
+    LinearRamp<float> ramp;     ///< Ramp towards the current parameter value
+    std::vector<float> values;  ///< Smoothed values of the current block
+    int rampLength = 1;         ///< Ramp length in samples
+};
+
+/**
+ * @brief 32-bit fixed-point phase accumulator
+ *
+ * One full cycle maps to the whole 32-bit range, so the phase wraps for free on
+ * integer overflow and keeps the same resolution however long a note is held.
+ */
+class PhaseAccumulator {
+public:
+    static constexpr double cycleLength = 4294967296.0; ///< Fixed-point value of one cycle (2^32)
+
+    /**
+     * @brief Convert a phase increment in cycles per sample to fixed point
+     * @param cyclesPerSample Increment in cycles per sample (clamped to 0.0 to 0.5)
+     * @return Fixed-point phase increment
+     */
+    static juce::uint32 toIncrement(double cyclesPerSample) {
+        return static_cast<juce::uint32>(juce::jlimit(0.0, 0.5, cyclesPerSample) * cycleLength);
+    }
+
+    /**
+     * @brief Convert a fixed-point phase to a normalized phase
+     * @param fixedPhase Fixed-point phase
+     * @return Normalized phase (0.0 to 1.0, exclusive)
+     */
+    static forcedinline float toNormalized(juce::uint32 fixedPhase) noexcept {
+        // Keep 24 bits so the result is exact in a float and never rounds up to 1.0
+        return static_cast<float>(fixedPhase >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * @brief Set the increment from a frequency
+     * @param frequency Frequency in Hz
+     * @param sampleRate Sample rate in Hz
+     */
+    void setFrequency(double frequency, double sampleRate) {
+        increment = sampleRate > 0.0 ? toIncrement(frequency / sampleRate) : 0u;
+    }
+
+    /**
+     * @brief Set the fixed-point increment directly
+     * @param newIncrement Fixed-point phase increment per sample
+     */
+    void setIncrement(juce::uint32 newIncrement) { increment = newIncrement; }
+
+    /**
+     * @brief Get the fixed-point increment
+     * @return Phase increment per sample
+     */
+    juce::uint32 getIncrement() const { return increment; }
+
+    /**
+     * @brief Reset the phase
+     * @param startPhase Fixed-point start phase
+     */
+    void reset(juce::uint32 startPhase = 0u) { phase = startPhase; }
+
+    /**
+     * @brief Get the current fixed-point phase
+     * @return Phase (a full cycle spans the 32-bit range)
+     */
+    juce::uint32 getPhase() const { return phase; }
+
+    /**
+     * @brief Get the current normalized phase
+     * @return Phase (0.0 to 1.0, exclusive)
+     */
+    float getNormalizedPhase() const { return toNormalized(phase); }
+
+    /**
+     * @brief Advance the phase by one sample
+     * @return Phase before advancing
+     */
+    forcedinline juce::uint32 advance() noexcept {
+        const juce::uint32 current = phase;
+        phase += increment; // Wraps around at the end of the cycle
+        return current;
+    }
+
+private:
+    juce::uint32 phase = 0u;     ///< Current fixed-point phase
+    juce::uint32 increment = 0u; ///< Fixed-point increment per sample
+};
+
+/**
+ * @brief Lock-free single-producer single-consumer queue with a fixed capacity
+ *
+ * Built on juce::AbstractFifo, so push() and pop() never lock or allocate and can be
+ * used between the audio thread and the message thread. Exactly one thread may push
+ * and exactly one thread may pop.
+ * @tparam T Trivially copyable element type
+ * @tparam Capacity Maximum number of queued elements
+ */
+template <typename T, int Capacity>
+class SPSCQueue {
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "Queue elements are copied between threads");
+    static_assert(Capacity > 0, "Queue needs at least one slot");
+
+    /**
+     * @brief Constructor
+     */
+    SPSCQueue() = default;
+
+    /**
+     * @brief Add an element (producer thread only)
+     * @param element Element to add
+     * @return False if the queue is full and the element was dropped
+     */
+    bool push(const T& element) noexcept {
+        const auto scope = fifo.write(1);
+        if (scope.blockSize1 + scope.blockSize2 == 0) {
+            return false;
+        }
+
+        storage[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = element;
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer thread only)
+     * @param element Receives the removed element
+     * @return False if the queue was empty
+     */
+    bool pop(T& element) noexcept {
+        const auto scope = fifo.read(1);
+        if (scope.blockSize1 + scope.blockSize2 == 0) {
+            return false;
+        }
+
+        element = storage[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)];
+        return true;
+    }
+
+    /**
+     * @brief Get the number of queued elements
+     * @return Number of elements ready to be popped
+     */
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+
+private:
+    // AbstractFifo keeps one slot free to tell a full queue from an empty one
+    juce::AbstractFifo fifo{Capacity + 1};   ///< Lock-free read/write index bookkeeping
+    std::array<T, Capacity + 1> storage{};   ///< Element storage
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SPSCQueue)
+};
+
+/**
+ * @brief Wait-free triple buffer passing snapshots from one writer thread to one reader thread
+ *
+ * The writer fills the back buffer and publishes it with a single atomic exchange; the
+ * reader swaps the most recently published buffer to the front with another exchange.
+ * Neither side ever waits or sees a partially written snapshot, and the reader always
+ * gets the newest one (older unread snapshots are dropped).
+ * @tparam T Snapshot type (preallocated, never resized while in use)
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Constructor
+     */
+    TripleBuffer() = default;
+
+    /**
+     * @brief Get the buffer to fill (writer thread only)
+     * @return Back buffer, not visible to the reader until publish()
+     */
+    T& getWriteBuffer() noexcept { return buffers[static_cast<size_t>(writeIndex)]; }
+
+    /**
+     * @brief Publish the back buffer (writer thread only)
+     */
+    void publish() noexcept {
+        writeIndex = sharedState.exchange(writeIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /**
+     * @brief Fetch the newest published buffer if there is one (reader thread only)
+     * @return True if getReadBuffer() changed
+     */
+    bool update() noexcept {
+        if ((sharedState.load(std::memory_order_relaxed) & freshFlag) == 0) {
+            return false;
+        }
+
+        readIndex = sharedState.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    /**
+     * @brief Get the most recently fetched snapshot (reader thread only)
+     * @return Front buffer
+     */
+    const T& getReadBuffer() const noexcept { return buffers[static_cast<size_t>(readIndex)]; }
+
+private:
+    static constexpr int indexMask = 3; ///< Bits holding the index of the shared buffer
+    static constexpr int freshFlag = 4; ///< Set if the shared buffer was published but not fetched
+
+    std::array<T, 3> buffers{};           ///< Back, shared and front buffer
+    int writeIndex = 0;                   ///< Back buffer (writer thread)
+    std::atomic<int> sharedState{1};      ///< Shared buffer index and fresh flag
+    int readIndex = 2;                    ///< Front buffer (reader thread)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TripleBuffer)
+};
+
+/**
+ * @brief Most recent output samples for the waveform display
+ */
+struct WaveformSnapshot {
+    static constexpr int capacity = 2048; ///< Maximum number of samples in a snapshot
+
+    std::array<float, capacity> samples{}; ///< Samples in chronological order
+    int numSamples = 0;                    ///< Number of valid samples
+    juce::int64 endPosition = 0;           ///< Absolute position after the last sample in the snapshot
+    juce::uint32 version = 0;              ///< Incremented whenever the displayed shape changes
+};
+
+/**
+ * @brief Min/max decimation pyramid over the most recent waveform samples
+ *
+ * Level k stores the minimum and maximum of aligned groups of 2^k samples, addressed by
+ * absolute sample position. Only the samples that are new since the previous snapshot
+ * (and their parent groups) are recalculated, and the range of any span of samples is
+ * found by combining at most two groups per level.
+ */
+class MinMaxPyramid {
+public:
+    static constexpr int capacity = WaveformSnapshot::capacity; ///< Samples covered by the pyramid
+    static_assert(juce::isPowerOfTwo(capacity), "Pyramid capacity must be a power of two");
+
+    /**
+     * @brief Add the samples of a snapshot that are not in the pyramid yet
+     * @param snapshot Newest waveform snapshot
+     * @return True if the pyramid changed
+     */
+    bool update(const WaveformSnapshot &snapshot) {
+        const int numSamples = juce::jlimit(0, capacity, snapshot.numSamples);
+        juce::int64 numNew = snapshot.endPosition - endPosition;
+
+        if (numNew == 0 && numSamples == numValid) {
+            return false;
+        }
+
+        // Rebuild completely after a reset or a gap larger than the snapshot
+        if (numNew <= 0 || numNew > numSamples || numSamples != numValid) {
+            numNew = numSamples;
+        }
+
+        const juce::int64 first = snapshot.endPosition - numNew;
+        const float *source = snapshot.samples.data() + (numSamples - numNew);
+        for (juce::int64 position = first; position < snapshot.endPosition; ++position) {
+            const auto index = static_cast<size_t>(position & (capacity - 1));
+            minimum[index] = maximum[index] = *source++;
+        }
+
+        // Recalculate the parent groups of the new samples, level by level
+        for (int level = 1; level < numLevels; ++level) {
+            const juce::int64 lastGroup = (snapshot.endPosition - 1) >> level;
+            for (juce::int64 group = first >> level; group <= lastGroup; ++group) {
+                const auto left = slot(level - 1, group * 2);
+                const auto right = slot(level - 1, group * 2 + 1);
+                const auto parent = slot(level, group);
+                minimum[parent] = juce::jmin(minimum[left], minimum[right]);
+                maximum[parent] = juce::jmax(maximum[left], maximum[right]);
+            }
+        }
+
+        endPosition = snapshot.endPosition;
+        numValid = numSamples;
+        return true;
+    }
+
+    /**
+     * @brief Get the sample range of a span of samples
+     * @param start First absolute sample position (clamped to the valid samples)
+     * @param end Absolute position after the last sample (clamped to the valid samples)
+     * @return Minimum and maximum sample value, or an empty range at 0 if no sample is valid
+     */
+    juce::Range<float> getRange(juce::int64 start, juce::int64 end) const {
+        start = juce::jmax(start, getStartPosition());
+        end = juce::jmin(end, endPosition);
+        if (start >= end) {
+            return {};
+        }
+
+        float low = std::numeric_limits<float>::max();
+        float high = std::numeric_limits<float>::lowest();
+        const auto include = [&](int level, juce::int64 group) {
+            const auto index = slot(level, group);
+            low = juce::jmin(low, minimum[index]);
+            high = juce::jmax(high, maximum[index]);
+        };
+
+        // Take the unaligned groups at each end, then continue one level up
+        for (int level = 0; start < end; ++level) {
+            jassert(level < numLevels);
+            if ((start & 1) != 0) {
+                include(level, start++);
+            }
+            if ((end & 1) != 0) {
+                include(level, --end);
+            }
+            start >>= 1;
+            end >>= 1;
+        }
+
+        return {low, high};
+    }
+
+    /**
+     * @brief Get the absolute position of the oldest valid sample
+     * @return Sample position
+     */
+    juce::int64 getStartPosition() const { return endPosition - numValid; }
+
+    /**
+     * @brief Get the absolute position after the newest sample
+     * @return Sample position
+     */
+    juce::int64 getEndPosition() const { return endPosition; }
+
+    /**
+     * @brief Get the number of valid samples
+     * @return Number of samples (at most capacity)
+     */
+    int getNumSamples() const { return numValid; }
+
+private:
+    /// Number of levels including the samples themselves
+    static constexpr int numLevels = [] {
+        int levels = 1;
+        for (int size = capacity; size > 1; size >>= 1) {
+            ++levels;
+        }
+        return levels;
+    }();
+
+    /**
+     * @brief Get the storage index of a group
+     * @param level Pyramid level (group size 2^level)
+     * @param group Absolute group index at that level
+     * @return Index into minimum and maximum
+     */
+    static size_t slot(int level, juce::int64 group) {
+        const int levelOffset = 2 * capacity - ((2 * capacity) >> level);
+        return static_cast<size_t>(levelOffset + (group & ((capacity >> level) - 1)));
+    }
+
+    std::array<float, 2 * capacity> minimum{}; ///< Group minima of all levels
+    std::array<float, 2 * capacity> maximum{}; ///< Group maxima of all levels
+    juce::int64 endPosition = 0;               ///< Absolute position after the newest sample
+    int numValid = 0;                          ///< Number of valid samples
+};
+
 /**
  * @brief Thread-safe circular buffer for audio data visualization
  */
@@ -71,21 +551,53 @@ public:
         : buffer(channels, size), writePosition(0) {}
 
     /**
-     * @brief Write a sample to the buffer
-     * @param channel Channel index
-     * @param sample Audio sample value
+     * @brief Write a block of samples and advance the write position once
+     *
+     * Every channel is copied with at most two memcpy calls (split at the wrap point),
+     * and the new write position is published with a single store.
+     * @param source Buffer to copy from (channels beyond the ring's channel count are ignored)
+     * @param numSamples Number of samples to copy (only the newest getNumSamples() are kept)
      */
-    void writeSample(int channel, float sample) {
-        if (channel < buffer.getNumChannels()) {
-            buffer.setSample(channel, writePosition.load(), sample);
+    void writeBlock(const juce::AudioBuffer<float> &source, int numSamples) {
+        const int size = buffer.getNumSamples();
+        const int numChannels = juce::jmin(buffer.getNumChannels(), source.getNumChannels());
+        if (size == 0 || numSamples <= 0) {
+            return;
+        }
+
+        const int count = juce::jmin(numSamples, size);
+        const int sourceStart = numSamples - count;
+        const int position = writePosition.load(std::memory_order_relaxed);
+        const int firstPart = juce::jmin(count, size - position);
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const float *input = source.getReadPointer(channel, sourceStart);
+            float *ring = buffer.getWritePointer(channel);
+            std::memcpy(ring + position, input, static_cast<size_t>(firstPart) * sizeof(float));
+            std::memcpy(ring, input + firstPart, static_cast<size_t>(count - firstPart) * sizeof(float));
         }
+
+        writePosition.store((position + count) % size, std::memory_order_release);
     }
 
     /**
-     * @brief Advance the write position
+     * @brief Copy the newest samples of a channel in chronological order
+     * @param channel Channel index
+     * @param destination Buffer receiving the samples
+     * @param numSamples Number of samples to copy
+     * @param delay Number of newest samples to leave out (numSamples + delay at most getBuffer().getNumSamples())
      */
-    void advanceWritePosition() {
-        writePosition = (writePosition.load() + 1) % buffer.getNumSamples();
+    void readLatest(int channel, float *destination, int numSamples, int delay = 0) const {
+        const int size = buffer.getNumSamples();
+        jassert(channel < buffer.getNumChannels() && delay >= 0 && numSamples + delay <= size);
+
+        const int end = (writePosition.load(std::memory_order_acquire) - delay + size) % size;
+        const int start = (end - numSamples + size) % size;
+        const int firstPart = juce::jmin(numSamples, size - start);
+
+        const float *ring = buffer.getReadPointer(channel);
+        std::memcpy(destination, ring + start, static_cast<size_t>(firstPart) * sizeof(float));
+        std::memcpy(destination + firstPart, ring, static_cast<size_t>(numSamples - firstPart) * sizeof(float));
     }
 
     /**
@@ -127,7 +639,7 @@ namespace AudioUtils {
      * @return Frequency in Hz
      */
     inline float midiNoteToFrequency(int noteNumber) {
-        return 440.0f * std::pow(2.0f, (noteNumber - 69) / 12.0f);
+        return 440.0f * FastMath::exp2((noteNumber - 69) / 12.0f);
     }
 
     /**
@@ -142,7 +654,7 @@ namespace AudioUtils {
             return sample;
         }
         float sign = (sample > 0.0f) ? 1.0f : -1.0f;
-        return sign * (threshold + (1.0f - threshold) * std::tanh((abs_sample - threshold) / (1.0f - threshold)));
+        return sign * (threshold + (1.0f - threshold) * FastMath::tanh((abs_sample - threshold) / (1.0f - threshold)));
     }
 
     /**
@@ -153,7 +665,7 @@ namespace AudioUtils {
      * @return Interpolated value
      */
     template<typename T>
-    inline T lerp(T a, T b, float t) {
+    constexpr T lerp(T a, T b, float t) {
         return a + t * (b - a);
     }
 }
\ No newline at end of file
@@ -3,12 +3,9 @@
 
 //==============================================================================
 VUMeterComponent::VUMeterComponent() {
-    // Start the timer for regular updates
-    startTimer(TIMER_INTERVAL_MS);
-}
-
-VUMeterComponent::~VUMeterComponent() {
-    stopTimer();
+    litSegments = {getLevelSegments(0.0f), getLevelSegments(0.0f)};
+    peakSegments = {getPeakSegments(0.0f), getPeakSegments(0.0f)};
+    loudnessText = getLoudnessText();
 }
 
 //==============================================================================
@@ -18,69 +15,85 @@ void VUMeterComponent::updateLevels(float leftLevel, float rightLevel) {
     rightLevelAtomic.store(juce::jlimit(0.0f, 1.0f, rightLevel));
 }
 
+void VUMeterComponent::updatePeaks(float leftTruePeak, float rightTruePeak) {
+    // Keep the highest peak until the next frame picks it up
+    leftPeakAtomic.store(juce::jmax(leftPeakAtomic.load(), juce::jlimit(0.0f, 1.0f, leftTruePeak)));
+    rightPeakAtomic.store(juce::jmax(rightPeakAtomic.load(), juce::jlimit(0.0f, 1.0f, rightTruePeak)));
+}
+
+void VUMeterComponent::updateLoudness(float lufs) {
+    loudnessAtomic.store(juce::jmax(MIN_LUFS, lufs));
+}
+
 void VUMeterComponent::setColorScheme(juce::Colour primary, juce::Colour secondary) {
     primaryColor = primary;
     secondaryColor = secondary;
+    backgroundImage = {}; // Border color is part of the background
     repaint();
 }
 
 void VUMeterComponent::reset() {
     leftLevelAtomic.store(0.0f);
     rightLevelAtomic.store(0.0f);
+    leftPeakAtomic.store(0.0f);
+    rightPeakAtomic.store(0.0f);
+    loudnessAtomic.store(MIN_LUFS);
+    loudness = MIN_LUFS;
     leftLevel = 0.0f;
     rightLevel = 0.0f;
     leftPeak = 0.0f;
     rightPeak = 0.0f;
     leftPeakHoldCounter = 0;
     rightPeakHoldCounter = 0;
+    litSegments = {getLevelSegments(0.0f), getLevelSegments(0.0f)};
+    peakSegments = {getPeakSegments(0.0f), getPeakSegments(0.0f)};
+    loudnessText = getLoudnessText();
     repaint();
 }
 
 //==============================================================================
 void VUMeterComponent::paint(juce::Graphics& g) {
-    auto bounds = getLocalBounds().toFloat();
+    // Static layer, rendered once per size, color scheme and display scale
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (backgroundImage.isNull() || !juce::approximatelyEqual(scale, backgroundScale)) {
+        renderBackground(scale);
+    }
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
 
-    // Background
-    g.setColour(juce::Colours::black.withAlpha(0.8f));
-    g.fillRoundedRectangle(bounds, 5.0f);
+    // Dynamic overlay
+    drawChannelLevels(g, 0);
+    drawChannelLevels(g, 1);
 
-    // Border
-    g.setColour(primaryColor.withAlpha(0.5f));
-    g.drawRoundedRectangle(bounds, 5.0f, 2.0f);
-
-    // Calculate meter areas
-    auto meterBounds = bounds.reduced(10.0f);
-    auto channelWidth = (meterBounds.getWidth() - 10.0f) * 0.5f;
-
-    // Left channel
-    auto leftChannelBounds = juce::Rectangle<float>(
-        meterBounds.getX(),
-        meterBounds.getY(),
-        channelWidth,
-        meterBounds.getHeight()
-    );
-
-    // Right channel
-    auto rightChannelBounds = juce::Rectangle<float>(
-        leftChannelBounds.getRight() + 10.0f,
-        meterBounds.getY(),
-        channelWidth,
-        meterBounds.getHeight()
-    );
-
-    // Draw channel meters
-    drawChannelMeter(g, leftChannelBounds, leftLevel, leftPeak, "L");
-    drawChannelMeter(g, rightChannelBounds, rightLevel, rightPeak, "R");
+    // Short-term loudness readout below the meters
+    g.setColour(juce::Colours::white.withAlpha(0.8f));
+    g.setFont(juce::FontOptions(10.0f));
+    g.drawText(loudnessText, loudnessBounds, juce::Justification::centred);
 }
 
 void VUMeterComponent::resized() {
+    // Calculate meter areas
+    auto bounds = getLocalBounds().toFloat().reduced(10.0f);
+    loudnessBounds = bounds.removeFromBottom(LOUDNESS_TEXT_HEIGHT);
+    auto channelWidth = (bounds.getWidth() - 10.0f) * 0.5f;
+
+    channelBounds[0] = bounds.removeFromLeft(channelWidth);
+    channelBounds[1] = bounds.withTrimmedLeft(10.0f).withWidth(channelWidth);
+
+    for (size_t channel = 0; channel < channelBounds.size(); ++channel) {
+        // Channel label on top, LEDs below
+        meterBounds[channel] = channelBounds[channel].withTrimmedTop(20.0f).reduced(2.0f);
+    }
+
+    backgroundImage = {};
 }
 
-void VUMeterComponent::timerCallback() {
-    // Get atomic values
+void VUMeterComponent::advanceFrame() {
+    // Get atomic values (true-peaks are collected until this frame)
     float newLeftLevel = leftLevelAtomic.load();
     float newRightLevel = rightLevelAtomic.load();
-
+    float newLeftPeak = juce::jmax(newLeftLevel, leftPeakAtomic.exchange(0.0f));
+    float newRightPeak = juce::jmax(newRightLevel, rightPeakAtomic.exchange(0.0f));
+    loudness = loudnessAtomic.load();
 
     // Update left channel
     if (newLeftLevel > leftLevel) {
@@ -91,9 +104,9 @@ void VUMeterComponent::timerCallback() {
     }
 
     // Update left peak
-    if (newLeftLevel > leftPeak) {
-        leftPeak = newLeftLevel;
-        leftPeakHoldCounter = static_cast<int>(PEAK_HOLD_TIME_MS / TIMER_INTERVAL_MS);
+    if (newLeftPeak > leftPeak) {
+        leftPeak = newLeftPeak;
+        leftPeakHoldCounter = static_cast<int>(PEAK_HOLD_TIME_MS / FRAME_INTERVAL_MS);
     } else if (leftPeakHoldCounter > 0) {
         leftPeakHoldCounter--;
     } else {
@@ -110,16 +123,39 @@ void VUMeterComponent::timerCallback() {
     }
 
     // Update right peak
-    if (newRightLevel > rightPeak) {
-        rightPeak = newRightLevel;
-        rightPeakHoldCounter = static_cast<int>(PEAK_HOLD_TIME_MS / TIMER_INTERVAL_MS);
+    if (newRightPeak > rightPeak) {
+        rightPeak = newRightPeak;
+        rightPeakHoldCounter = static_cast<int>(PEAK_HOLD_TIME_MS / FRAME_INTERVAL_MS);
     } else if (rightPeakHoldCounter > 0) {
         rightPeakHoldCounter--;
     } else {
         rightPeak *= PEAK_DECAY_RATE;
         if (rightPeak < 0.001f) rightPeak = 0.0f;
     }
-    repaint();
+
+    // Repaint only the parts whose look changed
+    const std::array<float, 2> levels{leftLevel, rightLevel};
+    const std::array<float, 2> peaks{leftPeak, rightPeak};
+    for (size_t channel = 0; channel < levels.size(); ++channel) {
+        const auto lit = getLevelSegments(levels[channel]);
+        const auto peak = getPeakSegments(peaks[channel]);
+        if (lit != litSegments[channel] || peak != peakSegments[channel]) {
+            litSegments[channel] = lit;
+            peakSegments[channel] = peak;
+            repaint(meterBounds[channel].getSmallestIntegerContainer());
+        }
+    }
+
+    auto text = getLoudnessText();
+    if (text != loudnessText) {
+        loudnessText = std::move(text);
+        repaint(loudnessBounds.getSmallestIntegerContainer());
+    }
+}
+
+bool VUMeterComponent::isSettled() const {
+    return leftLevel <= 0.0f && rightLevel <= 0.0f && leftPeak <= 0.0f && rightPeak <= 0.0f
+           && loudness <= MIN_LUFS;
 }
 
 //==============================================================================
@@ -148,61 +184,86 @@ juce::Colour VUMeterComponent::getColorForLevel(float db) const {
     }
 }
 
-void VUMeterComponent::drawChannelMeter(juce::Graphics& g, juce::Rectangle<float> bounds,
-                                       float level, float peak, const juce::String& channelName) {
+juce::Rectangle<float> VUMeterComponent::getSegmentBounds(int channel, int segment) const {
+    const auto& bounds = meterBounds[static_cast<size_t>(channel)];
+    float segmentHeight = (bounds.getHeight() - (NUM_SEGMENTS - 1) * 1.0f) / NUM_SEGMENTS;
+    float segmentTop = bounds.getBottom() - (segment + 1) * (segmentHeight + 1.0f);
+
+    return {bounds.getX() + 1.0f, segmentTop, bounds.getWidth() - 2.0f, segmentHeight};
+}
+
+juce::uint32 VUMeterComponent::getLevelSegments(float level) const {
+    float levelPosition = dbToMeterPosition(levelToDb(level));
+    juce::uint32 segments = 0;
+
+    for (int i = 0; i < NUM_SEGMENTS; ++i) {
+        float segmentNormalizedPosition = static_cast<float>(i) / static_cast<float>(NUM_SEGMENTS - 1);
+        if (segmentNormalizedPosition <= levelPosition) {
+            segments |= 1u << i;
+        }
+    }
+    return segments;
+}
+
+juce::uint32 VUMeterComponent::getPeakSegments(float peak) const {
+    float peakPosition = dbToMeterPosition(levelToDb(peak));
+    juce::uint32 segments = 0;
+
+    for (int i = 0; i < NUM_SEGMENTS; ++i) {
+        float segmentNormalizedPosition = static_cast<float>(i) / static_cast<float>(NUM_SEGMENTS - 1);
+        if (std::abs(segmentNormalizedPosition - peakPosition) < (1.0f / NUM_SEGMENTS)) {
+            segments |= 1u << i;
+        }
+    }
+    return segments;
+}
+
+juce::String VUMeterComponent::getLoudnessText() const {
+    return loudness > MIN_LUFS ? juce::String(loudness, 1) + " LUFS" : juce::String("-inf LUFS");
+}
+
+void VUMeterComponent::renderBackground(float scale) {
+    const auto bounds = getLocalBounds().toFloat();
+    backgroundScale = scale;
+    backgroundImage = juce::Image(juce::Image::ARGB,
+                                  juce::jmax(1, juce::roundToInt(bounds.getWidth() * scale)),
+                                  juce::jmax(1, juce::roundToInt(bounds.getHeight() * scale)), true);
+
+    juce::Graphics g(backgroundImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    // Background
+    g.setColour(juce::Colours::black.withAlpha(0.8f));
+    g.fillRoundedRectangle(bounds, 5.0f);
+
+    // Border
+    g.setColour(primaryColor.withAlpha(0.5f));
+    g.drawRoundedRectangle(bounds, 5.0f, 2.0f);
+
+    drawChannelBackground(g, 0, "L");
+    drawChannelBackground(g, 1, "R");
+}
+
+void VUMeterComponent::drawChannelBackground(juce::Graphics& g, int channel, const juce::String& channelName) {
+    const auto& bounds = channelBounds[static_cast<size_t>(channel)];
+    const auto& meterArea = meterBounds[static_cast<size_t>(channel)];
+
     // Draw channel label
-    auto labelBounds = bounds.removeFromTop(20.0f);
     g.setColour(juce::Colours::white);
     g.setFont(juce::FontOptions(14.0f, juce::Font::bold));
-    g.drawText(channelName, labelBounds, juce::Justification::centred);
+    g.drawText(channelName, bounds.withHeight(20.0f), juce::Justification::centred);
 
     // Meter background
-    auto meterBounds = bounds.reduced(2.0f);
     g.setColour(juce::Colours::black.withAlpha(0.3f));
-    g.fillRoundedRectangle(meterBounds, 2.0f);
-
-    // Calculate segment dimensions
-    float segmentHeight = (meterBounds.getHeight() - (NUM_SEGMENTS - 1) * 1.0f) / NUM_SEGMENTS;
-    float meterWidth = meterBounds.getWidth();
+    g.fillRoundedRectangle(meterArea, 2.0f);
 
-    // Convert levels to dB and positions
-    float levelDb = levelToDb(level);
-    float peakDb = levelToDb(peak);
-    float levelPosition = dbToMeterPosition(levelDb);
-    float peakPosition = dbToMeterPosition(peakDb);
-
-    // Draw segments from bottom to top
+    // Unlit segments from bottom to top
     for (int i = 0; i < NUM_SEGMENTS; ++i) {
-        float segmentTop = meterBounds.getBottom() - (i + 1) * (segmentHeight + 1.0f);
         float segmentNormalizedPosition = static_cast<float>(i) / static_cast<float>(NUM_SEGMENTS - 1);
-
-        juce::Rectangle<float> segmentBounds(
-            meterBounds.getX() + 1.0f,
-            segmentTop,
-            meterWidth - 2.0f,
-            segmentHeight
-        );
-
-        // Determine segment color based on level
         float segmentDb = MIN_DB + segmentNormalizedPosition * (MAX_DB - MIN_DB);
-        juce::Colour segmentColor = getColorForLevel(segmentDb);
 
-        // Draw segment based on current level
-        if (segmentNormalizedPosition <= levelPosition) {
-            // Active segment
-            g.setColour(segmentColor);
-            g.fillRoundedRectangle(segmentBounds, 1.0f);
-        } else {
-            // Inactive segment
-            g.setColour(segmentColor.withAlpha(0.2f));
-            g.fillRoundedRectangle(segmentBounds, 1.0f);
-        }
-
-        // Draw peak indicator
-        if (std::abs(segmentNormalizedPosition - peakPosition) < (1.0f / NUM_SEGMENTS)) {
-            g.setColour(juce::Colours::white);
-            g.fillRoundedRectangle(segmentBounds.reduced(0.5f), 1.0f);
-        }
+        g.setColour(getColorForLevel(segmentDb).withAlpha(0.2f));
+        g.fillRoundedRectangle(getSegmentBounds(channel, i), 1.0f);
     }
 
     // Draw dB scale markings on the right side
@@ -216,7 +277,7 @@ void VUMeterComponent::drawChannelMeter(juce::Graphics& g, juce::Rectangle<float
         for (float dbMark : dbMarks) {
             if (dbMark >= MIN_DB && dbMark <= MAX_DB) {
                 float markPosition = dbToMeterPosition(dbMark);
-                float yPos = meterBounds.getBottom() - (markPosition * meterBounds.getHeight());
+                float yPos = meterArea.getBottom() - (markPosition * meterArea.getHeight());
 
                 g.drawText(juce::String(static_cast<int>(dbMark)),
                           bounds.getRight() + 5.0f, yPos - 6.0f, 30.0f, 12.0f,
@@ -227,4 +288,26 @@ void VUMeterComponent::drawChannelMeter(juce::Graphics& g, juce::Rectangle<float
             }
         }
     }
-}
\ No newline at end of file
+}
+
+void VUMeterComponent::drawChannelLevels(juce::Graphics& g, int channel) {
+    const auto lit = litSegments[static_cast<size_t>(channel)];
+    const auto peak = peakSegments[static_cast<size_t>(channel)];
+
+    for (int i = 0; i < NUM_SEGMENTS; ++i) {
+        const auto segmentBounds = getSegmentBounds(channel, i);
+
+        // Active segment (unlit segments are part of the background)
+        if ((lit >> i) & 1u) {
+            float segmentNormalizedPosition = static_cast<float>(i) / static_cast<float>(NUM_SEGMENTS - 1);
+            g.setColour(getColorForLevel(MIN_DB + segmentNormalizedPosition * (MAX_DB - MIN_DB)));
+            g.fillRoundedRectangle(segmentBounds, 1.0f);
+        }
+
+        // Draw peak indicator
+        if ((peak >> i) & 1u) {
+            g.setColour(juce::Colours::white);
+            g.fillRoundedRectangle(segmentBounds.reduced(0.5f), 1.0f);
+        }
+    }
+}
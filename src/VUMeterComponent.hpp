@@ -1,6 +1,7 @@
 #pragma once
 
 #include "JuceHeader.h"
+#include "FrameScheduler.hpp"
 #include <atomic>
 #include <array>
 
@@ -10,7 +11,7 @@
  * This component provides a professional-looking VU meter with peak and RMS level display,
  * including proper ballistics and color-coded level indicators.
  */
-class VUMeterComponent : public juce::Component, public juce::Timer {
+class VUMeterComponent : public juce::Component {
 public:
     /**
      * @brief Constructor
@@ -20,7 +21,7 @@ public:
     /**
      * @brief Destructor
      */
-    ~VUMeterComponent() override;
+    ~VUMeterComponent() override = default;
     
     /**
      * @brief Update the meter with new audio level data
@@ -28,6 +29,19 @@ public:
      * @param rightLevel Right channel level (0.0 to 1.0)
      */
     void updateLevels(float leftLevel, float rightLevel);
+
+    /**
+     * @brief Update the peak indicators with new true-peak data
+     * @param leftTruePeak Left channel true-peak since the previous update (linear)
+     * @param rightTruePeak Right channel true-peak since the previous update (linear)
+     */
+    void updatePeaks(float leftTruePeak, float rightTruePeak);
+
+    /**
+     * @brief Update the loudness readout
+     * @param lufs Short-term loudness in LUFS
+     */
+    void updateLoudness(float lufs);
     
     /**
      * @brief Set the color scheme for the meter
@@ -41,6 +55,17 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Advance the meter ballistics by one frame and repaint what changed
+     */
+    void advanceFrame();
+
+    /**
+     * @brief Check if the meter shows silence and has nothing left to animate
+     * @return True if all levels and peaks have decayed and no loudness is shown
+     */
+    bool isSettled() const;
+
     //==============================================================================
     // Component overrides
     
@@ -54,11 +79,6 @@ public:
      * @brief Handle component resizing
      */
     void resized() override;
-    
-    /**
-     * @brief Timer callback for updating meter ballistics
-     */
-    void timerCallback() override;
 
 private:
     /**
@@ -81,29 +101,69 @@ private:
      * @return Color for the level
      */
     juce::Colour getColorForLevel(float db) const;
-    
+
+    /**
+     * @brief Render the static parts (frame, labels, unlit segments, dB scale) into the background image
+     * @param scale Physical pixels per logical pixel of the display
+     */
+    void renderBackground(float scale);
+
     /**
-     * @brief Draw a single channel meter
+     * @brief Draw the static parts of a single channel meter
      * @param g Graphics context
-     * @param bounds Bounds for the meter
-     * @param level Current level (0.0 to 1.0)
-     * @param peak Peak level (0.0 to 1.0)
+     * @param channel Channel index (0 = left, 1 = right)
      * @param channelName Name of the channel
      */
-    void drawChannelMeter(juce::Graphics& g, juce::Rectangle<float> bounds, 
-                         float level, float peak, const juce::String& channelName);
+    void drawChannelBackground(juce::Graphics& g, int channel, const juce::String& channelName);
+
+    /**
+     * @brief Draw the lit segments and peak indicator of a single channel meter
+     * @param g Graphics context
+     * @param channel Channel index (0 = left, 1 = right)
+     */
+    void drawChannelLevels(juce::Graphics& g, int channel);
+
+    /**
+     * @brief Get the bounds of one LED segment
+     * @param channel Channel index (0 = left, 1 = right)
+     * @param segment Segment index (0 = bottom)
+     * @return Segment bounds
+     */
+    juce::Rectangle<float> getSegmentBounds(int channel, int segment) const;
+
+    /**
+     * @brief Get the segments lit by a level
+     * @param level Linear level (0.0 to 1.0)
+     * @return Bit n set if segment n is lit
+     */
+    juce::uint32 getLevelSegments(float level) const;
+
+    /**
+     * @brief Get the segments marked by the peak indicator
+     * @param peak Linear peak level (0.0 to 1.0)
+     * @return Bit n set if segment n shows the peak
+     */
+    juce::uint32 getPeakSegments(float peak) const;
+
+    /**
+     * @brief Get the text of the loudness readout
+     * @return Loudness text
+     */
+    juce::String getLoudnessText() const;
 
     //==============================================================================
     // Constants
     
-    static constexpr int UPDATE_RATE_HZ = 60;           ///< Update rate in Hz
-    static constexpr int TIMER_INTERVAL_MS = 1000 / UPDATE_RATE_HZ; ///< Timer interval
+    static constexpr int FRAME_INTERVAL_MS = 1000 / FrameScheduler::frameRateHz; ///< Interval of animated frames
     static constexpr float PEAK_HOLD_TIME_MS = 1500.0f; ///< Peak hold time in milliseconds
     static constexpr float PEAK_DECAY_RATE = 0.99f;     ///< Peak decay rate per update
     static constexpr float LEVEL_DECAY_RATE = 0.95f;    ///< Level decay rate per update
     static constexpr float MIN_DB = -60.0f;             ///< Minimum dB value to display
     static constexpr float MAX_DB = 6.0f;               ///< Maximum dB value to display
     static constexpr int NUM_SEGMENTS = 20;             ///< Number of LED segments per channel
+    static_assert(NUM_SEGMENTS <= 32, "Segments are tracked as 32-bit masks");
+    static constexpr float MIN_LUFS = -70.0f;           ///< Loudness shown as silence
+    static constexpr float LOUDNESS_TEXT_HEIGHT = 14.0f; ///< Height of the loudness readout
     
     //==============================================================================
     // Member variables
@@ -111,17 +171,35 @@ private:
     // Level data (thread-safe)
     std::atomic<float> leftLevelAtomic{0.0f};           ///< Left channel level (atomic)
     std::atomic<float> rightLevelAtomic{0.0f};          ///< Right channel level (atomic)
+    std::atomic<float> leftPeakAtomic{0.0f};            ///< Left channel true-peak since last frame (atomic)
+    std::atomic<float> rightPeakAtomic{0.0f};           ///< Right channel true-peak since last frame (atomic)
+    std::atomic<float> loudnessAtomic{MIN_LUFS};        ///< Short-term loudness in LUFS (atomic)
     
-    // Display levels (accessed from timer thread)
+    // Display levels (accessed from the message thread)
     float leftLevel{0.0f};                              ///< Left channel display level
     float rightLevel{0.0f};                             ///< Right channel display level
     float leftPeak{0.0f};                               ///< Left channel peak level
     float rightPeak{0.0f};                              ///< Right channel peak level
+    float loudness{MIN_LUFS};                           ///< Displayed short-term loudness in LUFS
     
     // Peak hold timing
     int leftPeakHoldCounter{0};                         ///< Left peak hold counter
     int rightPeakHoldCounter{0};                        ///< Right peak hold counter
     
+    // Layout (calculated in resized)
+    std::array<juce::Rectangle<float>, 2> channelBounds; ///< Label and meter area of each channel
+    std::array<juce::Rectangle<float>, 2> meterBounds;   ///< LED area of each channel
+    juce::Rectangle<float> loudnessBounds;              ///< Loudness readout area
+
+    // Static background, redrawn only on resize or color changes
+    juce::Image backgroundImage;                        ///< Cached static layer
+    float backgroundScale{0.0f};                        ///< Display scale the background was rendered for
+
+    // Painted state, so only changed areas are repainted
+    std::array<juce::uint32, 2> litSegments{};          ///< Segments lit by the level of each channel
+    std::array<juce::uint32, 2> peakSegments{};         ///< Segments showing the peak of each channel
+    juce::String loudnessText;                          ///< Displayed loudness readout
+
     // Colors
     juce::Colour primaryColor{juce::Colours::green};    ///< Primary meter color
     juce::Colour secondaryColor{juce::Colours::darkgreen}; ///< Secondary meter color
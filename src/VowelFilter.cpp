@@ -5,11 +5,92 @@ VowelFilter::VowelFilter() {
     // Constructor implementation if needed
 }
 
-float VowelFilter::processSample(float inputSample, OscType oscType, float angle, float morphValue) {
-    return getVowelMorphSample(oscType, angle, morphValue);
+FormantCoefficients VowelFilter::makeCoefficients(float morphValue, double sampleRate) {
+    const VowelFormants formants = getCurrentVowelFormants(morphValue);
+    const std::array<float, numFormants> frequencies{formants.f1, formants.f2, formants.f3};
+    const std::array<float, numFormants> amplitudes{formants.a1, formants.a2, formants.a3};
+
+    alignas(SIMDFloat::SIMDRegisterSize) float a1[SIMDFloat::SIMDNumElements]{};
+    alignas(SIMDFloat::SIMDRegisterSize) float a2[SIMDFloat::SIMDNumElements]{};
+    alignas(SIMDFloat::SIMDRegisterSize) float a3[SIMDFloat::SIMDNumElements]{};
+    alignas(SIMDFloat::SIMDRegisterSize) float gain[SIMDFloat::SIMDNumElements]{};
+
+    for (size_t band = 0; band < numFormants; ++band) {
+        // TPT state-variable filter (Zavalishin / Simper), prewarped cutoff kept below Nyquist
+        const double cutoff = juce::jmin(static_cast<double>(frequencies[band]), sampleRate * 0.45);
+        const double g = std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+        const double k = 1.0 / formantQ[band];
+
+        a1[band] = static_cast<float>(1.0 / (1.0 + g * (g + k)));
+        a2[band] = static_cast<float>(g * a1[band]);
+        a3[band] = static_cast<float>(g * a2[band]);
+
+        // k * band-pass output has unity gain at the formant frequency
+        gain[band] = static_cast<float>(k) * amplitudes[band] * outputGain;
+    }
+
+    FormantCoefficients coefficients;
+    coefficients.a1 = SIMDFloat::fromRawArray(a1);
+    coefficients.a2 = SIMDFloat::fromRawArray(a2);
+    coefficients.a3 = SIMDFloat::fromRawArray(a3);
+    coefficients.gain = SIMDFloat::fromRawArray(gain);
+    coefficients.wet = juce::jlimit(0.0f, 1.0f, morphValue);
+    return coefficients;
+}
+
+void VowelFilter::setCoefficients(const FormantCoefficients& newCoefficients) {
+    target = newCoefficients;
+
+    if (!hasCoefficients) {
+        current = target;
+        hasCoefficients = true;
+    }
+}
+
+void VowelFilter::reset() {
+    ic1eq = SIMDFloat::expand(0.0f);
+    ic2eq = SIMDFloat::expand(0.0f);
+    hasCoefficients = false;
 }
 
-VowelFormants VowelFilter::interpolateVowels(const VowelFormants& vowel1, const VowelFormants& vowel2, float t) {
+void VowelFilter::processBlock(float* samples, int numSamples) noexcept {
+    if (numSamples <= 0) {
+        return;
+    }
+
+    // Linear coefficient ramps across the block
+    const float rampScale = 1.0f / static_cast<float>(numSamples);
+    const SIMDFloat a1Step = (target.a1 - current.a1) * rampScale;
+    const SIMDFloat a2Step = (target.a2 - current.a2) * rampScale;
+    const SIMDFloat a3Step = (target.a3 - current.a3) * rampScale;
+    const SIMDFloat gainStep = (target.gain - current.gain) * rampScale;
+    const float wetStep = (target.wet - current.wet) * rampScale;
+
+    SIMDFloat a1 = current.a1, a2 = current.a2, a3 = current.a3, gain = current.gain;
+    float wet = current.wet;
+
+    for (int i = 0; i < numSamples; ++i) {
+        a1 += a1Step;
+        a2 += a2Step;
+        a3 += a3Step;
+        gain += gainStep;
+        wet += wetStep;
+
+        // All formant bands at once, one band per lane
+        const SIMDFloat v3 = SIMDFloat::expand(samples[i]) - ic2eq;
+        const SIMDFloat v1 = a1 * ic1eq + a2 * v3;
+        const SIMDFloat v2 = ic2eq + a2 * ic1eq + a3 * v3;
+        ic1eq = v1 * 2.0f - ic1eq;
+        ic2eq = v2 * 2.0f - ic2eq;
+
+        const float formantSample = (gain * v1).sum();
+        samples[i] += (formantSample - samples[i]) * wet * intensity;
+    }
+
+    current = target;
+}
+
+constexpr VowelFormants VowelFilter::interpolateVowels(const VowelFormants& vowel1, const VowelFormants& vowel2, float t) {
     VowelFormants result;
     result.f1 = AudioUtils::lerp(vowel1.f1, vowel2.f1, t);
     result.f2 = AudioUtils::lerp(vowel1.f2, vowel2.f2, t);
@@ -20,7 +101,7 @@ VowelFormants VowelFilter::interpolateVowels(const VowelFormants& vowel1, const
     return result;
 }
 
-VowelFormants VowelFilter::getVowelFormants(VowelType vowel) {
+constexpr VowelFormants VowelFilter::getVowelFormants(VowelType vowel) {
     switch (vowel) {
         case VowelType::A: return vowelA;
         case VowelType::E: return vowelE;
@@ -31,9 +112,9 @@ VowelFormants VowelFilter::getVowelFormants(VowelType vowel) {
     }
 }
 
-VowelFormants VowelFilter::getCurrentVowelFormants(float morphValue) {
+constexpr VowelFormants VowelFilter::computeVowelFormants(float morphValue) {
     // Clamp morph value
-    morphValue = juce::jlimit(0.0f, 1.0f, morphValue);
+    morphValue = std::clamp(morphValue, 0.0f, 1.0f);
 
     // Interpolation between vowels based on morphValue (0.0 to 1.0)
     if (morphValue <= 0.25f) {
@@ -58,31 +139,18 @@ VowelFormants VowelFilter::getCurrentVowelFormants(float morphValue) {
     }
 }
 
-float VowelFilter::getVowelMorphSample(OscType oscType, float angle, float vowelMorphValue) {
-    // Generate base sample based on oscillator type
-    float baseSample = OscillatorUtils::getOscSample(oscType, angle);
-
-    // Create temporary vowel filter instance for formant calculation
-    VowelFilter tempFilter;
-    VowelFormants currentVowel = tempFilter.getCurrentVowelFormants(vowelMorphValue);
-
-    // Formant filter simulation through harmonic component overlay
-    // Simplified approach: Modulate the signal with the formants
-    float formantSample = 0.0f;
-
-    // First formant (strongest)
-    float formant1 = std::sin(angle * currentVowel.f1 / 440.0f) * currentVowel.a1;
-    formantSample += formant1 * 0.5f;
-
-    // Second formant
-    float formant2 = std::sin(angle * currentVowel.f2 / 440.0f) * currentVowel.a2;
-    formantSample += formant2 * 0.3f;
+constexpr std::array<VowelFormants, VowelFilter::morphTableSize> VowelFilter::buildMorphTable() {
+    std::array<VowelFormants, morphTableSize> table{};
+    for (int i = 0; i < morphTableSize; ++i) {
+        table[static_cast<size_t>(i)] = computeVowelFormants(static_cast<float>(i) / (morphTableSize - 1));
+    }
+    return table;
+}
 
-    // Third formant (weakest)
-    float formant3 = std::sin(angle * currentVowel.f3 / 440.0f) * currentVowel.a3;
-    formantSample += formant3 * 0.2f;
+// Constant-initialized: lives in read-only data, no per-instance or startup cost
+constinit const std::array<VowelFormants, VowelFilter::morphTableSize> VowelFilter::morphTable = buildMorphTable();
 
-    // Mix the original signal with the formants
-    float morphFactor = vowelMorphValue * 0.8f; // Maximum 80% vowel content
-    return juce::jmap(morphFactor, baseSample, baseSample * (1.0f + formantSample * 0.5f));
-}
\ No newline at end of file
+VowelFormants VowelFilter::getCurrentVowelFormants(float morphValue) {
+    const int index = juce::roundToInt(juce::jlimit(0.0f, 1.0f, morphValue) * (morphTableSize - 1));
+    return morphTable[static_cast<size_t>(index)];
+}
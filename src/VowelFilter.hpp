@@ -1,6 +1,7 @@
 #pragma once
 #include "JuceHeader.h"
-#include "Oscillator.hpp"
+#include "Utils.hpp"
+#include <algorithm>
 #include <array>
 
 /**
@@ -40,14 +41,38 @@ enum class VowelType {
     U   ///< Vowel "U"
 };
 
+/**
+ * @brief Ready-to-use resonator coefficients for one vowel morph position
+ *
+ * Each SIMD lane holds one formant band (lanes beyond the third have zero gain),
+ * so all bands of the resonator bank are updated with one instruction.
+ */
+struct FormantCoefficients {
+    using SIMDFloat = juce::dsp::SIMDRegister<float>; ///< SIMD register type
+
+    SIMDFloat a1 = SIMDFloat::expand(0.0f);   ///< TPT state-variable filter coefficient a1 per band
+    SIMDFloat a2 = SIMDFloat::expand(0.0f);   ///< TPT state-variable filter coefficient a2 per band
+    SIMDFloat a3 = SIMDFloat::expand(0.0f);   ///< TPT state-variable filter coefficient a3 per band
+    SIMDFloat gain = SIMDFloat::expand(0.0f); ///< Output gain per band (formant amplitude, unity-peak band-pass)
+    float wet = 0.0f;                         ///< Vowel content before intensity scaling (0.0 to 1.0)
+};
+
 /**
  * @brief Vowel morphing filter for formant synthesis
  *
- * This class implements vowel formant filtering by modulating the input signal
- * with characteristic formant frequencies of different vowels.
+ * Three parallel resonant band-pass filters (TPT state-variable filters) at the
+ * formant frequencies of the current vowel. The bands are processed together in
+ * one juce::dsp::SIMDRegister. Coefficients are computed only when the morph value
+ * changes and are interpolated across each block to avoid zipper noise.
  */
 class VowelFilter {
 public:
+    using SIMDFloat = FormantCoefficients::SIMDFloat; ///< SIMD register type
+    static constexpr int numFormants = 3;             ///< Number of resonator bands
+    static constexpr int morphTableSize = 1024;       ///< Entries of the precomputed vowel morph table
+
+    static_assert(SIMDFloat::SIMDNumElements >= numFormants, "All formant bands must fit into one SIMD register");
+
     /**
      * @brief Constructor
      */
@@ -59,23 +84,32 @@ public:
     ~VowelFilter() = default;
 
     /**
-     * @brief Process a sample with vowel morphing
-     * @param inputSample Input audio sample
-     * @param oscType Oscillator type for base waveform
-     * @param angle Current oscillator phase angle
+     * @brief Compute the resonator coefficients for a morph position
      * @param morphValue Morphing value (0.0 = A, 1.0 = U)
-     * @return Processed sample with vowel characteristics
+     * @param sampleRate Sample rate in Hz
+     * @return Coefficients for setCoefficients()
+     */
+    static FormantCoefficients makeCoefficients(float morphValue, double sampleRate);
+
+    /**
+     * @brief Set the coefficients to reach by the end of the next block
+     *
+     * After reset() the coefficients are applied immediately instead of being interpolated.
+     * @param newCoefficients Coefficients from makeCoefficients()
      */
-    float processSample(float inputSample, OscType oscType, float angle, float morphValue);
+    void setCoefficients(const FormantCoefficients& newCoefficients);
 
     /**
-     * @brief Get vowel morphed sample (static utility function)
-     * @param oscType Oscillator type
-     * @param angle Current phase angle
-     * @param vowelMorphValue Morphing value (0.0 to 1.0)
-     * @return Processed sample
+     * @brief Clear the filter state (call when a silent voice starts a new note)
      */
-    static float getVowelMorphSample(OscType oscType, float angle, float vowelMorphValue);
+    void reset();
+
+    /**
+     * @brief Filter a block in place, interpolating the coefficients across it
+     * @param samples Audio samples to process
+     * @param numSamples Number of samples
+     */
+    void processBlock(float* samples, int numSamples) noexcept;
 
     /**
      * @brief Set the intensity of the vowel effect
@@ -97,21 +131,37 @@ private:
      * @param t Interpolation factor (0.0 to 1.0)
      * @return Interpolated vowel formants
      */
-    VowelFormants interpolateVowels(const VowelFormants& vowel1, const VowelFormants& vowel2, float t);
+    static constexpr VowelFormants interpolateVowels(const VowelFormants& vowel1, const VowelFormants& vowel2, float t);
 
     /**
      * @brief Get vowel formants for specific vowel type
      * @param vowel Vowel type
      * @return Vowel formants structure
      */
-    VowelFormants getVowelFormants(VowelType vowel);
+    static constexpr VowelFormants getVowelFormants(VowelType vowel);
+
+    /**
+     * @brief Calculate vowel formants for a morph value by interpolating between the vowels
+     * @param morphValue Morphing value (0.0 to 1.0)
+     * @return Interpolated vowel formants
+     */
+    static constexpr VowelFormants computeVowelFormants(float morphValue);
 
     /**
-     * @brief Calculate current vowel formants based on morph value
+     * @brief Build the vowel morph table at compile time
+     * @return Formants for morphTableSize evenly spaced morph values from 0.0 to 1.0
+     */
+    static constexpr std::array<VowelFormants, morphTableSize> buildMorphTable();
+
+    /**
+     * @brief Look up the vowel formants for a morph value in the precomputed table
      * @param morphValue Morphing value (0.0 to 1.0)
      * @return Current vowel formants
      */
-    VowelFormants getCurrentVowelFormants(float morphValue);
+    static VowelFormants getCurrentVowelFormants(float morphValue);
+
+    /// Vowel morph table, built at compile time and shared read-only by every instance in the process
+    static const std::array<VowelFormants, morphTableSize> morphTable;
 
     // Predefined vowel formants (approximated for synthesizer use)
     static constexpr VowelFormants vowelA{800.0f, 1200.0f, 2500.0f, 1.0f, 0.7f, 0.3f};  ///< Vowel "A" formants
@@ -120,5 +170,14 @@ private:
     static constexpr VowelFormants vowelO{500.0f, 900.0f, 2200.0f, 1.0f, 0.6f, 0.2f};   ///< Vowel "O" formants
     static constexpr VowelFormants vowelU{300.0f, 700.0f, 2100.0f, 1.0f, 0.5f, 0.1f};   ///< Vowel "U" formants
 
-    float intensity = 0.8f; ///< Effect intensity (0.0 to 1.0)
-};
\ No newline at end of file
+    // Resonance of each band (formant frequency / bandwidth) and make-up gain of the band-pass sum
+    static constexpr std::array<float, numFormants> formantQ{6.0f, 8.0f, 10.0f}; ///< Q per formant band
+    static constexpr float outputGain = 2.0f;                                     ///< Make-up gain of the band sum
+
+    FormantCoefficients current;        ///< Coefficients used for the current sample
+    FormantCoefficients target;         ///< Coefficients reached at the end of the block
+    SIMDFloat ic1eq = SIMDFloat::expand(0.0f); ///< First integrator state per band
+    SIMDFloat ic2eq = SIMDFloat::expand(0.0f); ///< Second integrator state per band
+    bool hasCoefficients = false;       ///< False until coefficients were set after reset()
+    float intensity = 0.8f;             ///< Effect intensity (maximum vowel content, 0.0 to 1.0)
+};
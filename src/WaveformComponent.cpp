@@ -7,12 +7,10 @@
 
 /**
  * @brief Constructs the WaveformComponent
- * @param bufferRef Reference to the audio buffer to visualize
- * @param writePosRef Reference to the current write position in the buffer
+ * @param snapshotsRef Snapshots published by the audio thread (this component is their only reader)
  */
-WaveformComponent::WaveformComponent(juce::AudioSampleBuffer &bufferRef, int &writePosRef)
-    : buffer(bufferRef), writePos(writePosRef) {
-    startTimerHz(60); // Starts timer to refresh display at ~60 frames per second
+WaveformComponent::WaveformComponent(TripleBuffer<WaveformSnapshot> &snapshotsRef)
+    : snapshots(snapshotsRef) {
 }
 
 /**
@@ -50,48 +48,92 @@ void WaveformComponent::paint(juce::Graphics &g) {
 }
 
 /**
- * @brief Timer callback that triggers repainting
- * Called approximately 60 times per second to update the display
+ * @brief Sizes the column summary for the new width
  */
-void WaveformComponent::timerCallback() {
+void WaveformComponent::resized() {
+    const int width = juce::jmax(0, static_cast<int>(getLocalBounds().toFloat().reduced(3.0f).getWidth()));
+    columns.assign(static_cast<size_t>(width), juce::Range<float>());
+    updateColumns();
     repaint();
 }
 
 /**
- * @brief Draws the waveform visualization
- * @param g The graphics context used for drawing
+ * @brief Fetches the newest snapshot and triggers repainting
+ * Called once per editor frame. The processor only publishes a snapshot when the shape
+ * changed; a new version is folded into the pyramid and repainted if the drawn columns changed
  */
-void WaveformComponent::drawWaveform(juce::Graphics &g) const {
-    auto bounds = getLocalBounds().toFloat().reduced(3.0f); // Account for border
-    auto width = bounds.getWidth();
-    auto height = bounds.getHeight();
-    auto centerY = bounds.getCentreY();
-
-    juce::Path waveformPath;
-    waveformPath.startNewSubPath(bounds.getX(), centerY); // Start path at vertical center
-
-    const int numSamples = buffer.getNumSamples();
-    if (numSamples == 0) {
-        // Draw a flat line if no samples
-        waveformPath.lineTo(bounds.getRight(), centerY);
-        g.strokePath(waveformPath, juce::PathStrokeType(1.5f));
+void WaveformComponent::refresh() {
+    if (!snapshots.update()) {
         return;
     }
 
-    const float step = static_cast<float>(numSamples) / width; // Calculate samples per pixel
-    const int start = (writePos + 1) % numSamples;             // Get starting point after current write position
-
-    // Draw the waveform point by point
-    for (int i = 0; i < static_cast<int>(width); ++i) {
-        // Calculate the actual sample index with wraparound
-        const float index = std::fmod(start + i * step, static_cast<float>(numSamples));
-        // Get the audio sample value at this index
-        const float sample = buffer.getSample(0, static_cast<int>(index));
-        // Map the sample value (-1 to 1) to screen coordinates within the reduced bounds
-        const float y = juce::jmap(sample, -1.0f, 1.0f, bounds.getBottom(), bounds.getY());
-        waveformPath.lineTo(bounds.getX() + static_cast<float>(i), y);
+    const auto &snapshot = snapshots.getReadBuffer();
+    if (snapshot.version == drawnVersion) {
+        return;
+    }
+
+    drawnVersion = snapshot.version;
+    if (pyramid.update(snapshot) && updateColumns()) {
+        repaint();
+    }
+}
+
+/**
+ * @brief Recalculates the sample range of every pixel column and the spans to draw
+ * @return True if any column changed
+ */
+bool WaveformComponent::updateColumns() {
+    const int width = static_cast<int>(columns.size());
+    const int numSamples = pyramid.getNumSamples();
+    const juce::int64 start = pyramid.getStartPosition();
+    bool changed = false;
+
+    for (int i = 0; i < width; ++i) {
+        // Columns narrower than a sample repeat the sample under them
+        const juce::int64 first = start + static_cast<juce::int64>(i) * numSamples / width;
+        const juce::int64 last = juce::jmax(first + 1, start + static_cast<juce::int64>(i + 1) * numSamples / width);
+        const auto range = pyramid.getRange(first, last);
+
+        auto &column = columns[static_cast<size_t>(i)];
+        if (range != column) {
+            column = range;
+            changed = true;
+        }
+    }
+
+    if (!changed && !waveformSpans.isEmpty()) {
+        return false;
+    }
+
+    auto bounds = getLocalBounds().toFloat().reduced(3.0f); // Account for border
+    waveformSpans.clear();
+    waveformSpans.ensureStorageAllocated(width);
+
+    for (int i = 0; i < width; ++i) {
+        auto range = columns[static_cast<size_t>(i)];
+
+        // Reach the previous column, so steep edges stay connected
+        if (i > 0) {
+            const auto &previous = columns[static_cast<size_t>(i - 1)];
+            range = {juce::jmin(range.getStart(), previous.getEnd()), juce::jmax(range.getEnd(), previous.getStart())};
+        }
+
+        // Map the sample range (-1 to 1) to screen coordinates, at least as thick as the old 1.5 px line
+        const float top = juce::jmap(juce::jlimit(-1.0f, 1.0f, range.getEnd()), -1.0f, 1.0f, bounds.getBottom(), bounds.getY());
+        const float bottom = juce::jmap(juce::jlimit(-1.0f, 1.0f, range.getStart()), -1.0f, 1.0f, bounds.getBottom(), bounds.getY());
+        const float centre = (top + bottom) * 0.5f;
+        const float height = juce::jmax(1.5f, bottom - top);
+        waveformSpans.addWithoutMerging({bounds.getX() + static_cast<float>(i), centre - height * 0.5f, 1.0f, height});
     }
 
-    // Draw the waveform with slightly thicker line for better visibility
-    g.strokePath(waveformPath, juce::PathStrokeType(1.5f));
-}
\ No newline at end of file
+    return true;
+}
+
+/**
+ * @brief Draws the waveform visualization
+ * @param g The graphics context used for drawing
+ */
+void WaveformComponent::drawWaveform(juce::Graphics &g) const {
+    // One vertical span per pixel column, prepared in updateColumns()
+    g.fillRectList(waveformSpans);
+}
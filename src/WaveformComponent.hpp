@@ -1,13 +1,21 @@
 #pragma once
 
 #include "JuceHeader.h"
+#include "Utils.hpp"
 
-class WaveformComponent : public juce::Component, public juce::Timer {
+class WaveformComponent : public juce::Component {
 public:
-  WaveformComponent(juce::AudioSampleBuffer &bufferRef, int &writePosRef);
+  WaveformComponent(TripleBuffer<WaveformSnapshot> &snapshotsRef);
 
   void paint(juce::Graphics &g) override;
 
+  void resized() override;
+
+  /**
+   * @brief Fetch the newest snapshot and repaint if the drawn waveform changed (call once per frame)
+   */
+  void refresh();
+
   /**
    * @brief Set the color scheme for the waveform and border
    * @param waveColor Color for the waveform line
@@ -16,12 +24,15 @@ public:
   void setColorScheme(juce::Colour waveColor, juce::Colour borderColor);
 
 private:
-  void timerCallback() override;
-
   void drawWaveform(juce::Graphics &g) const;
 
-  juce::AudioSampleBuffer &buffer;
-  int &writePos;
+  bool updateColumns();
+
+  TripleBuffer<WaveformSnapshot> &snapshots; // Read side is owned by this component
+  MinMaxPyramid pyramid;                     // Min/max summary of the newest snapshot
+  juce::uint32 drawnVersion = 0;             // Version of the snapshot in the pyramid
+  std::vector<juce::Range<float>> columns;   // Sample range per pixel column (sized in resized)
+  juce::RectangleList<float> waveformSpans;  // Vertical spans drawn by paint
 
   // Color scheme
   juce::Colour waveformColor = juce::Colours::lime;
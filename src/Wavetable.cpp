@@ -0,0 +1,78 @@
+#include "Wavetable.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr int analysisOrder = 14;                 ///< FFT order used to analyse the naive waveforms
+    constexpr int analysisSize = 1 << analysisOrder;  ///< Oversampled analysis length
+    constexpr int tableOrder = WavetableBank::tableBits; ///< FFT order matching WavetableBank::tableSize
+    constexpr int tableStride = WavetableBank::tableSize + 1;
+}
+
+// WavetableBank Implementation
+void WavetableBank::prepare(double sampleRate) {
+    if (juce::approximatelyEqual(sampleRate, preparedSampleRate)) {
+        return; // Tables are already band-limited for this sample rate
+    }
+
+    preparedSampleRate = sampleRate;
+    tables.assign(static_cast<size_t>(OscType::NumTypes) * numOctaves * tableStride, 0.0f);
+
+    for (int type = 0; type < static_cast<int>(OscType::NumTypes); ++type) {
+        buildTables(static_cast<OscType>(type));
+    }
+}
+
+const float* WavetableBank::getTable(OscType type, float frequency) const {
+    const auto typeIndex = static_cast<size_t>(juce::jlimit(0, static_cast<int>(OscType::NumTypes) - 1,
+                                                            static_cast<int>(type)));
+    const auto octave = static_cast<size_t>(getOctaveIndex(frequency));
+    return tables.data() + (typeIndex * numOctaves + octave) * tableStride;
+}
+
+int WavetableBank::getOctaveIndex(float frequency) {
+    if (frequency <= lowestFrequency * 2.0f) {
+        return 0;
+    }
+    return juce::jlimit(0, numOctaves - 1, static_cast<int>(std::log2(frequency / lowestFrequency)));
+}
+
+void WavetableBank::buildTables(OscType type) {
+    using Complex = juce::dsp::Complex<float>;
+
+    // Analyse an oversampled naive cycle so its spectrum is not aliased itself
+    std::vector<float> naiveCycle(analysisSize);
+    OscillatorUtils::getCycleRenderer(type)(naiveCycle.data(), analysisSize);
+
+    std::vector<Complex> naive(analysisSize), spectrum(analysisSize);
+    std::transform(naiveCycle.begin(), naiveCycle.end(), naive.begin(), [](float value) { return Complex(value, 0.0f); });
+
+    juce::dsp::FFT analysisFft(analysisOrder);
+    analysisFft.perform(naive.data(), spectrum.data(), false);
+
+    juce::dsp::FFT tableFft(tableOrder);
+    std::vector<Complex> bandLimited(tableSize), cycle(tableSize);
+    const float scale = static_cast<float>(tableSize) / static_cast<float>(analysisSize);
+    const double nyquist = preparedSampleRate * 0.5;
+
+    for (int octave = 0; octave < numOctaves; ++octave) {
+        // Highest harmonic that stays below Nyquist for the top frequency of this octave
+        const double topFrequency = lowestFrequency * std::pow(2.0, octave + 1);
+        const int maxHarmonic = juce::jlimit(1, tableSize / 2 - 1, static_cast<int>(nyquist / topFrequency));
+
+        std::fill(bandLimited.begin(), bandLimited.end(), Complex());
+        bandLimited[0] = spectrum[0] * scale;
+        for (int harmonic = 1; harmonic <= maxHarmonic; ++harmonic) {
+            bandLimited[static_cast<size_t>(harmonic)] = spectrum[static_cast<size_t>(harmonic)] * scale;
+            bandLimited[static_cast<size_t>(tableSize - harmonic)] =
+                spectrum[static_cast<size_t>(analysisSize - harmonic)] * scale;
+        }
+
+        tableFft.perform(bandLimited.data(), cycle.data(), true);
+
+        float* table = tables.data() + (static_cast<size_t>(type) * numOctaves + static_cast<size_t>(octave)) * tableStride;
+        for (int i = 0; i < tableSize; ++i) {
+            table[i] = cycle[static_cast<size_t>(i)].real();
+        }
+        table[tableSize] = table[0];
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "JuceHeader.h"
+#include "Oscillator.hpp"
+#include <vector>
+
+/**
+ * @file Wavetable.hpp
+ * @brief Band-limited, mipmapped wavetables for the AvSynth audio plugin
+ */
+
+/**
+ * @brief Set of band-limited single-cycle tables for every oscillator type
+ *
+ * Each OscType is rendered once per octave with all harmonics above the Nyquist
+ * frequency of that octave removed, so playback by table lookup is alias-free.
+ * The tables are built in prepareToPlay() and only read on the audio thread.
+ */
+class WavetableBank {
+public:
+    static constexpr int tableBits = 11;              ///< log2 of the table size
+    static constexpr int tableSize = 1 << tableBits;  ///< Samples per single-cycle table
+    static constexpr int numOctaves = 11;             ///< Number of band-limited tables per type
+    static constexpr float lowestFrequency = 20.0f;   ///< Lower edge of the first octave in Hz
+
+    /**
+     * @brief Constructor
+     */
+    WavetableBank() = default;
+
+    /**
+     * @brief Destructor
+     */
+    ~WavetableBank() = default;
+
+    /**
+     * @brief Build all tables for the given sample rate (no-op if already built for it)
+     * @param sampleRate Sample rate in Hz
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Check if the tables have been built
+     * @return True if prepare() has been called
+     */
+    bool isPrepared() const { return preparedSampleRate > 0.0; }
+
+    /**
+     * @brief Get the band-limited table for an oscillator type and frequency
+     * @param type Oscillator type
+     * @param frequency Playback frequency in Hz
+     * @return Pointer to tableSize + 1 samples (last sample wraps to the first)
+     */
+    const float* getTable(OscType type, float frequency) const;
+
+    /**
+     * @brief Read a table with linear interpolation
+     * @param table Table returned by getTable()
+     * @param phase Normalized phase (0.0 to 1.0, exclusive)
+     * @return Interpolated table value
+     */
+    template <typename PhaseType>
+    static forcedinline float lookup(const float* table, PhaseType phase) noexcept {
+        const auto position = static_cast<float>(phase * tableSize);
+        const auto index = static_cast<int>(position);
+        const auto fraction = position - static_cast<float>(index);
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+    /**
+     * @brief Read a table with linear interpolation at a fixed-point phase
+     * @param table Table returned by getTable()
+     * @param phase Fixed-point phase from a PhaseAccumulator
+     * @return Interpolated table value
+     */
+    static forcedinline float lookup(const float* table, juce::uint32 phase) noexcept {
+        constexpr int fractionBits = 32 - tableBits;
+        constexpr juce::uint32 fractionMask = (1u << fractionBits) - 1u;
+
+        const auto index = phase >> fractionBits;
+        const auto fraction = static_cast<float>(phase & fractionMask) * (1.0f / static_cast<float>(1u << fractionBits));
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+private:
+    /**
+     * @brief Build all octave tables of one oscillator type
+     * @param type Oscillator type
+     */
+    void buildTables(OscType type);
+
+    /**
+     * @brief Get the octave table index for a frequency
+     * @param frequency Frequency in Hz
+     * @return Octave index (0 to numOctaves - 1)
+     */
+    static int getOctaveIndex(float frequency);
+
+    std::vector<float> tables;        ///< All tables, indexed [type][octave][sample]
+    double preparedSampleRate = 0.0;  ///< Sample rate the tables were built for
+};